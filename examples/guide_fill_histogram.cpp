@@ -45,6 +45,20 @@ int main() {
   // h2 is filled
   const double sum = std::accumulate(h2.begin(), h2.end(), 0.0);
   assert(sum == 3);
+
+  // bulk fill from columns of values, one column per axis; weights are optional and
+  // must be the first argument, like in the call operator
+  std::vector<double> xs = {0, 2, 4};
+  std::vector<double> ys = {1.2, 3.4, 5.6};
+  std::vector<double> ws = {1, 2, 3};
+
+  auto h3 = bh::make_histogram(bh::axis::regular<>(8, 0, 4),
+                               bh::axis::regular<>(10, 0, 5));
+  h3.fill(xs, ys);
+  h3.fill(bh::weight(ws), xs, ys);
+
+  const double sum3 = std::accumulate(h3.begin(), h3.end(), 0.0);
+  assert(sum3 == 9);
 }
 
 //]
@@ -8,6 +8,7 @@
 
 #include <atomic>
 #include <boost/histogram.hpp>
+#include <boost/histogram/algorithm/fill_parallel.hpp>
 #include <boost/histogram/algorithm/sum.hpp>
 #include <cassert>
 #include <functional>
@@ -49,14 +50,15 @@ int main() {
     Create histogram with container of atomic counters for parallel filling in several
     threads. You cannot use bare std::atomic here, because std::atomic types are not
     copyable. Using the copyable_atomic as a work-around is safe, if the storage does not
-    change size while it is filled. This means that growing axis types are not allowed.
+    change size while it is filled. This means that axes with option_type::growth are not
+    allowed.
   */
   auto h = bh::make_histogram_with(std::vector<copyable_atomic<std::size_t>>(),
                                    bh::axis::integer<>(0, 10));
 
   /*
     The histogram storage may not be resized in either thread. This is the case
-    if you do not use growing axis types. Some notes regarding std::thread.
+    if you do not use axes with option_type::growth. Some notes regarding std::thread.
     - The templated fill function must be instantiated when passed to std::thread, do we
       pass fill<decltype(h)>.
     - std::thread copies the argument. To avoid filling two copies of the histogram, we
@@ -72,6 +74,19 @@ int main() {
   t4.join();
 
   assert(bh::algorithm::sum(h) == 4000);
+
+  /*
+    Atomic counters become slow when many threads increment the same few bins. The
+    alternative is to fill a separate storage in each thread and to add them up at the
+    end. algorithm::fill_parallel does this for spans of values, like histogram::fill.
+    It does not need atomic counters and works with any storage.
+  */
+  std::vector<int> x(4000);
+  for (unsigned i = 0; i < x.size(); ++i) x[i] = i % 10;
+  auto h2 = bh::make_histogram(bh::axis::integer<>(0, 10));
+  bh::algorithm::fill_parallel(h2, 4, x);
+
+  assert(bh::algorithm::sum(h2) == 4000);
 }
 
 //]
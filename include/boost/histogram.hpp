@@ -16,10 +16,14 @@
 #include <boost/histogram/axis/category.hpp>
 #include <boost/histogram/axis/circular.hpp>
 #include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
 #include <boost/histogram/axis/variable.hpp>
 #include <boost/histogram/axis/variant.hpp>
+#include <boost/histogram/chunked_adaptive_storage.hpp>
 #include <boost/histogram/histogram.hpp>
+#include <boost/histogram/histogram_group.hpp>
 #include <boost/histogram/literals.hpp>
 #include <boost/histogram/make_histogram.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
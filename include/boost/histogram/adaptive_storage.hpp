@@ -122,9 +122,10 @@ struct adaptive_storage {
     char type;
     std::size_t size;
     void* ptr;
+    std::size_t capacity; // number of counters for which memory is allocated
 
     buffer_type(std::size_t s = 0, const allocator_type& a = allocator_type())
-        : alloc(a), type(0), size(s), ptr(nullptr) {}
+        : alloc(a), type(0), size(s), ptr(nullptr), capacity(0) {}
 
 #if defined(BOOST_MSVC)
 #pragma warning(push)
@@ -166,10 +167,12 @@ struct adaptive_storage {
 #pragma warning(pop)
 #endif
 
+    // p must point to a buffer with room for exactly size counters
     template <typename T>
     void set(T* p) {
       type = type_index<T>();
       ptr = p;
+      capacity = size;
     }
   };
 
@@ -206,6 +209,7 @@ struct adaptive_storage {
     o.buffer.type = 0;
     o.buffer.size = 0;
     o.buffer.ptr = nullptr;
+    o.buffer.capacity = 0;
   }
 
   adaptive_storage& operator=(adaptive_storage&& o) {
@@ -257,6 +261,13 @@ struct adaptive_storage {
     apply(incrementor(), buffer, i);
   }
 
+  // increase by one for each of n indices, the counter type is only looked up again
+  // after a counter was widened
+  void increment_n(const std::size_t* idx, std::size_t n) {
+    std::size_t k = 0;
+    while (k < n) k = apply(incrementor_n(), buffer, idx, k, n);
+  }
+
   // increase by weight
   template <typename T>
   void operator()(std::size_t i, const weight_type<T>& x) {
@@ -270,8 +281,24 @@ struct adaptive_storage {
     apply(adder(), buffer, i, x);
   }
 
+  // inserts n zero counters before index pos and keeps the counter type; memory is
+  // reserved with spare room, so that repeated insertions have amortized constant cost
+  // per counter if pos is close to the end
+  void insert_zeros(std::size_t pos, std::size_t n) {
+    BOOST_ASSERT(pos <= size());
+    apply(inserter(), buffer, pos, n);
+  }
+
   const_reference operator[](std::size_t i) const { return apply(getter(), buffer, i); }
 
+  // moves the counter at index i to index f(i) of a new buffer with s counters and keeps
+  // the counter type; f is called with increasing i, must be injective and map into
+  // [0, s)
+  template <typename F>
+  void remap(std::size_t s, F&& f) {
+    apply(remapper(), buffer, s, f);
+  }
+
   bool operator==(const adaptive_storage& o) const {
     if (size() != o.size()) return false;
     return apply(comparer(), buffer, o.buffer);
@@ -329,7 +356,7 @@ struct adaptive_storage {
       using alloc_type =
           typename std::allocator_traits<allocator_type>::template rebind_alloc<T>;
       alloc_type a(b.alloc); // rebind allocator
-      detail::destroy_buffer(a, tp, b.size);
+      detail::destroy_buffer(a, tp, b.size, b.capacity);
     }
 
     template <typename Buffer>
@@ -357,6 +384,74 @@ struct adaptive_storage {
     }
   };
 
+  struct remapper {
+    template <typename T, typename Buffer, typename F>
+    void operator()(T* tp, Buffer& b, std::size_t s, F& f) {
+      buffer_type nb(s, b.alloc);
+      T* ptr = nb.template create<T>();
+      nb.set(ptr);
+      try {
+        for (std::size_t i = 0; i < b.size; ++i) ptr[f(i)] = tp[i];
+      } catch (...) {
+        destroyer()(ptr, nb);
+        throw;
+      }
+      destroyer()(tp, b);
+      b.size = s;
+      b.set(ptr);
+    }
+
+    template <typename Buffer, typename F>
+    void operator()(void*, Buffer& b, std::size_t s, F&) {
+      b.size = s;
+    }
+  };
+
+  struct inserter {
+    template <typename T, typename Buffer>
+    void operator()(T* tp, Buffer& b, std::size_t pos, std::size_t n) {
+      using alloc_type =
+          typename std::allocator_traits<allocator_type>::template rebind_alloc<T>;
+      using AT = std::allocator_traits<alloc_type>;
+      alloc_type a(b.alloc); // rebind allocator
+      const auto size = b.size + n;
+      std::size_t k = b.size;
+      if (size <= b.capacity) {
+        try {
+          for (; k < size; ++k) AT::construct(a, tp + k, 0);
+        } catch (...) {
+          while (k != b.size) AT::destroy(a, tp + --k);
+          throw;
+        }
+        std::move_backward(tp + pos, tp + b.size, tp + size);
+        std::fill(tp + pos, tp + pos + n, 0);
+        b.size = size;
+        return;
+      }
+      const auto capacity = (std::max)(size, 2 * b.capacity);
+      T* ptr = AT::allocate(a, capacity);
+      k = 0;
+      try {
+        for (; k < pos; ++k) AT::construct(a, ptr + k, tp[k]);
+        for (; k < pos + n; ++k) AT::construct(a, ptr + k, 0);
+        for (; k < size; ++k) AT::construct(a, ptr + k, tp[k - n]);
+      } catch (...) {
+        while (k != 0) AT::destroy(a, ptr + --k);
+        AT::deallocate(a, ptr, capacity);
+        throw;
+      }
+      destroyer()(tp, b);
+      b.size = size;
+      b.set(ptr);
+      b.capacity = capacity;
+    }
+
+    template <typename Buffer>
+    void operator()(void*, Buffer& b, std::size_t, std::size_t n) {
+      b.size += n;
+    }
+  };
+
   struct incrementor {
     template <typename T, typename Buffer>
     void operator()(T* tp, Buffer& b, std::size_t i) {
@@ -387,6 +482,43 @@ struct adaptive_storage {
     }
   };
 
+  // returns position after the last processed index
+  struct incrementor_n {
+    template <typename T, typename Buffer>
+    std::size_t operator()(T* tp, Buffer& b, const std::size_t* idx, std::size_t k,
+                           std::size_t n) {
+      for (; k < n; ++k) {
+        BOOST_ASSERT(idx[k] < b.size);
+        if (!detail::safe_increment(tp[idx[k]])) {
+          incrementor()(tp, b, idx[k]);
+          return k + 1;
+        }
+      }
+      return k;
+    }
+
+    template <typename Buffer>
+    std::size_t operator()(void* tp, Buffer& b, const std::size_t* idx, std::size_t k,
+                           std::size_t) {
+      incrementor()(tp, b, idx[k]);
+      return k + 1;
+    }
+
+    template <typename Buffer>
+    std::size_t operator()(mp_int* tp, Buffer&, const std::size_t* idx, std::size_t k,
+                           std::size_t n) {
+      for (; k < n; ++k) ++tp[idx[k]];
+      return k;
+    }
+
+    template <typename Buffer>
+    std::size_t operator()(double* tp, Buffer&, const std::size_t* idx, std::size_t k,
+                           std::size_t n) {
+      for (; k < n; ++k) ++tp[idx[k]];
+      return k;
+    }
+  };
+
   struct adder {
     template <typename Buffer, typename U>
     void if_U_is_integral(std::true_type, mp_int* tp, Buffer&, std::size_t i,
@@ -0,0 +1,82 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_ALGORITHM_FILL_PARALLEL_HPP
+#define BOOST_HISTOGRAM_ALGORITHM_FILL_PARALLEL_HPP
+
+#include <algorithm>
+#include <boost/histogram/detail/fill_n.hpp>
+#include <boost/histogram/detail/parallel.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace algorithm {
+
+/**
+  Fill histogram with spans of values in several threads.
+
+  Accepts the same spans as histogram::fill, preceded by the number of threads. If the
+  number of threads is zero, std::thread::hardware_concurrency() threads are used. The
+  samples are split into contiguous ranges, one per thread. Each thread fills its own
+  storage, while the axes of the histogram are shared between all threads. At the end,
+  the storages are added pairwise in a tree, also in parallel, so that the merge takes
+  log2(number of threads) steps.
+
+  Threads do not touch shared counters, so this scales also when a few bins receive most
+  of the counts, where atomic counters suffer from contention. The price is the memory
+  for one storage per thread. The axes are only read, so this cannot be used with axes
+  that grow: std::invalid_argument is thrown if an axis has option_type::growth.
+*/
+template <typename A, typename S, typename... Ts>
+void fill_parallel(histogram<A, S>& h, unsigned nthreads, const Ts&... ts) {
+  const auto args = std::forward_as_tuple(ts...);
+  const auto& axes = unsafe_access::axes(h);
+  auto& storage = unsafe_access::storage(h);
+  const std::size_t size = detail::fill_n_check(axes, args);
+  if (detail::has_growth(axes))
+    throw std::invalid_argument("fill_parallel does not support axes that grow");
+
+  nthreads = detail::resolve_threads(nthreads);
+  // at least one block of samples per thread, more threads only add overhead
+  const auto nblocks =
+      (size + detail::fill_n_block_size - 1) / detail::fill_n_block_size;
+  if (nblocks < nthreads) nthreads = std::max(static_cast<unsigned>(nblocks), 1u);
+
+  if (nthreads == 1) {
+    detail::fill_n_range(storage, axes, args, 0, size);
+    return;
+  }
+
+  // first thread fills the histogram, all others fill a copy of an empty prototype
+  const auto nbins = storage.size();
+  S empty = detail::empty_storage(storage);
+  empty.reset(nbins);
+  std::vector<S> clones(nthreads - 1);
+  std::vector<S*> parts(nthreads, &storage);
+  for (unsigned k = 1; k < nthreads; ++k) parts[k] = &clones[k - 1];
+
+  std::vector<unsigned> ks(nthreads);
+  for (unsigned k = 0; k < nthreads; ++k) ks[k] = k;
+  detail::run_parallel(ks, [&](unsigned k) {
+    if (k > 0) *parts[k] = empty;
+    const auto begin = size * k / nthreads;
+    const auto end = size * (k + 1) / nthreads;
+    detail::fill_n_range(*parts[k], axes, args, begin, end);
+  });
+
+  detail::merge_parallel(parts);
+}
+
+} // namespace algorithm
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -14,20 +14,16 @@
 #include <boost/histogram/unsafe_access.hpp>
 #include <boost/mp11.hpp>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace boost {
 namespace histogram {
-namespace algorithm {
-
-/**
-  Returns a lower-dimensional histogram, summing over removed axes.
+namespace detail {
 
-  Arguments are the source histogram and compile-time numbers, representing the indices of
-  axes that are kept. Returns a new histogram which only contains the subset of axes.
-  The source histogram is summed over the removed axes.
-*/
+// returns the histogram with the kept axes and the mapper which fills it
 template <typename A, typename S, std::size_t I, typename... Ns>
-auto project(const histogram<A, S>& h, mp11::mp_size_t<I> n, Ns... ns) {
+auto make_projection(const histogram<A, S>& h, mp11::mp_size_t<I> n, Ns... ns) {
   using LN = mp11::mp_list<mp11::mp_size_t<I>, Ns...>;
   static_assert(mp11::mp_is_set<LN>::value, "indices must be unique");
 
@@ -57,18 +53,12 @@ auto project(const histogram<A, S>& h, mp11::mp_size_t<I> n, Ns... ns) {
     s *= axis::traits::extend(detail::axis_get<J>(axes));
   });
 
-  im(unsafe_access::storage(r_h), unsafe_access::storage(h));
-  return r_h;
+  return std::make_pair(std::move(r_h), im);
 }
 
-/**
-  Returns a lower-dimensional histogram, summing over removed axes.
-
-  This version accepts an iterable range that represents the indices which are kept.
-*/
 template <typename A, typename S, typename C, typename = detail::requires_axis_vector<A>,
           typename = detail::requires_iterable<C>>
-auto project(const histogram<A, S>& h, C c) {
+auto make_projection(const histogram<A, S>& h, C c) {
   using H = histogram<A, S>;
 
   auto begin = std::begin(c);
@@ -115,8 +105,65 @@ auto project(const histogram<A, S>& h, C c) {
                    [&h](auto) { return S(unsafe_access::storage(h).get_allocator()); },
                    [](auto) { return S(); }, 0));
 
-  im(unsafe_access::storage(r_h), unsafe_access::storage(h));
-  return r_h;
+  return std::make_pair(std::move(r_h), im);
+}
+
+} // namespace detail
+
+namespace algorithm {
+
+/**
+  Returns a lower-dimensional histogram, summing over removed axes.
+
+  Arguments are the source histogram and compile-time numbers, representing the indices of
+  axes that are kept. Returns a new histogram which only contains the subset of axes.
+  The source histogram is summed over the removed axes.
+*/
+template <typename A, typename S, std::size_t I, typename... Ns>
+auto project(const histogram<A, S>& h, mp11::mp_size_t<I> n, Ns... ns) {
+  auto p = detail::make_projection(h, n, ns...);
+  p.second(unsafe_access::storage(p.first), unsafe_access::storage(h));
+  return std::move(p.first);
+}
+
+/**
+  Returns a lower-dimensional histogram, summing over removed axes.
+
+  This version accepts an iterable range that represents the indices which are kept.
+*/
+template <typename A, typename S, typename C, typename = detail::requires_axis_vector<A>,
+          typename = detail::requires_iterable<C>>
+auto project(const histogram<A, S>& h, C c) {
+  auto p = detail::make_projection(h, c);
+  p.second(unsafe_access::storage(p.first), unsafe_access::storage(h));
+  return std::move(p.first);
+}
+
+/**
+  Returns several lower-dimensional histograms, reading the source histogram only once.
+
+  Accepts an iterable range of iterable ranges of axis indices. Returns a vector with
+  one histogram per inner range, equal to what project returns for that range, up to
+  the rounding of floating point sums, which may be added in a different order. Calling
+  project for each range reads the whole source storage each time, while this reads
+  each source bin once and adds it to all projections, which is faster when the
+  projections are limited by memory bandwidth.
+*/
+template <typename A, typename S, typename C, typename = detail::requires_axis_vector<A>,
+          typename = detail::requires_iterable<C>>
+std::vector<histogram<A, S>> project_many(const histogram<A, S>& h, const C& c) {
+  std::vector<histogram<A, S>> r;
+  std::vector<detail::index_mapper> ims;
+  for (const auto& x : c) {
+    auto p = detail::make_projection(h, x);
+    r.emplace_back(std::move(p.first));
+    ims.emplace_back(p.second);
+  }
+  std::vector<S*> dst;
+  dst.reserve(r.size());
+  for (auto&& x : r) dst.push_back(&unsafe_access::storage(x));
+  detail::map_many(ims, dst, unsafe_access::storage(h));
+  return r;
 }
 
 } // namespace algorithm
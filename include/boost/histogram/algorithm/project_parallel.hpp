@@ -0,0 +1,58 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_ALGORITHM_PROJECT_PARALLEL_HPP
+#define BOOST_HISTOGRAM_ALGORITHM_PROJECT_PARALLEL_HPP
+
+#include <boost/histogram/algorithm/project.hpp>
+#include <boost/histogram/detail/parallel.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <boost/mp11.hpp>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace algorithm {
+
+/**
+  Like project, but sums over the removed axes in several threads.
+
+  Accepts the same arguments as project, preceded by the number of threads. If the
+  number of threads is zero, std::thread::hardware_concurrency() threads are used. The
+  bins of the source histogram are split into contiguous ranges, one per thread. Each
+  thread sums its range into its own copy of the projected storage, the copies are then
+  added pairwise in a tree, also in parallel. Fewer threads are used for small source
+  histograms, where starting threads costs more than it gains.
+*/
+template <typename A, typename S, std::size_t I, typename... Ns>
+auto project_parallel(const histogram<A, S>& h, unsigned nthreads, mp11::mp_size_t<I> n,
+                      Ns... ns) {
+  auto p = detail::make_projection(h, n, ns...);
+  detail::map_parallel(p.second, unsafe_access::storage(p.first),
+                       unsafe_access::storage(h), nthreads);
+  return std::move(p.first);
+}
+
+/**
+  Like project, but sums over the removed axes in several threads.
+
+  This version accepts an iterable range that represents the indices which are kept.
+*/
+template <typename A, typename S, typename C, typename = detail::requires_axis_vector<A>,
+          typename = detail::requires_iterable<C>>
+auto project_parallel(const histogram<A, S>& h, unsigned nthreads, C c) {
+  auto p = detail::make_projection(h, c);
+  detail::map_parallel(p.second, unsafe_access::storage(p.first),
+                       unsafe_access::storage(h), nthreads);
+  return std::move(p.first);
+}
+
+} // namespace algorithm
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -18,6 +18,7 @@
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace boost {
 namespace histogram {
@@ -64,10 +65,45 @@ reduce_option_type shrink(double lower, double upper) { return shrink(0, lower,
 /// Convenience overload for when there is only one axis.
 reduce_option_type rebin(unsigned merge) { return rebin(0, merge); }
 
+} // namespace algorithm
+
+namespace detail {
+
+// sets positions of flow bins of axis a in the source (i = 0) or destination (i = 1)
+template <typename Axis>
+void set_flow_bins(index_mapper_reduce_item& d, int i, const Axis& a) {
+  switch (flow_bins(axis::traits::options(a))) {
+    case 1:
+      d.overflow[i] = a.size();
+      d.underflow[i] = -1;
+      break;
+    case 2:
+      d.overflow[i] = a.size();
+      d.underflow[i] = a.size() + 1;
+      break;
+    default: d.underflow[i] = -1; d.overflow[i] = -1;
+  };
+}
+
+// narrows bin range [begin, end) to the bins which are inside [lower, upper)
+template <typename Axis>
+void shrink_bins(const Axis& a, double lower, double upper, unsigned& begin,
+                 unsigned& end) {
+  if (lower < upper) {
+    while (begin != end && a.value(begin) < lower) ++begin;
+    while (end != begin && a.value(end - 1) >= upper) --end;
+  } else if (lower > upper) {
+    // for inverted axis::regular
+    while (begin != end && a.value(begin) > lower) ++begin;
+    while (end != begin && a.value(end - 1) <= upper) --end;
+  }
+}
+
+// returns the reduced histogram with empty storage and the mapper which fills it
 template <typename A, typename S, typename C, typename = detail::requires_iterable<C>>
-histogram<A, S> reduce(const histogram<A, S>& h, const C& c) {
-  auto options =
-      boost::container::static_vector<reduce_option_type, axis::limit>(h.rank());
+auto make_reduction(const histogram<A, S>& h, const C& c) {
+  auto options = boost::container::static_vector<algorithm::reduce_option_type,
+                                                axis::limit>(h.rank());
   for (const auto& o : c) {
     auto& opt_ref = options[o.iaxis];
     if (opt_ref) throw std::invalid_argument("indices must be unique");
@@ -89,44 +125,24 @@ histogram<A, S> reduce(const histogram<A, S>& h, const C& c) {
     im.total *= n;
     im_iter->stride[0] = stride[0];
     stride[0] *= n;
-    auto set_flow = [im_iter](int i, const auto& a) {
-      switch (axis::traits::options(a)) {
-        case axis::option_type::overflow:
-          im_iter->overflow[i] = a.size();
-          im_iter->underflow[i] = -1;
-          break;
-        case axis::option_type::underflow_and_overflow:
-          im_iter->overflow[i] = a.size();
-          im_iter->underflow[i] = a.size() + 1;
-          break;
-        default: im_iter->underflow[i] = -1; im_iter->overflow[i] = -1;
-      };
-    };
-    set_flow(0, a);
+    set_flow_bins(*im_iter, 0, a);
 
     const auto& opt = options[iaxis];
     unsigned begin = 0, end = a.size(), merge = 1;
     if (opt) {
       merge = opt.merge;
-      if (opt.lower < opt.upper) {
-        while (begin != end && a.value(begin) < opt.lower) ++begin;
-        while (end != begin && a.value(end - 1) >= opt.upper) --end;
-      } else if (opt.lower > opt.upper) {
-        // for inverted axis::regular
-        while (begin != end && a.value(begin) > opt.lower) ++begin;
-        while (end != begin && a.value(end - 1) <= opt.upper) --end;
-      }
+      shrink_bins(a, opt.lower, opt.upper, begin, end);
       end -= (end - begin) % merge;
       auto a2 = T(a, begin, end, merge);
       axis::get<T>(detail::axis_get(r_axes, iaxis)) = a2;
       im_iter->stride[1] = stride[1];
       stride[1] *= axis::traits::extend(a2);
-      set_flow(1, a2);
+      set_flow_bins(*im_iter, 1, a2);
     } else {
       axis::get<T>(detail::axis_get(r_axes, iaxis)) = a;
       im_iter->stride[1] = stride[1];
       stride[1] *= axis::traits::extend(a);
-      set_flow(1, a);
+      set_flow_bins(*im_iter, 1, a);
     }
     im_iter->begin = begin;
     im_iter->end = end;
@@ -141,8 +157,18 @@ histogram<A, S> reduce(const histogram<A, S>& h, const C& c) {
           [&h](auto) { return S(unsafe_access::storage(h).get_allocator()); },
           [](auto) { return S(); }, 0));
 
-  im(unsafe_access::storage(h_r), unsafe_access::storage(h));
-  return h_r;
+  return std::make_pair(std::move(h_r), im);
+}
+
+} // namespace detail
+
+namespace algorithm {
+
+template <typename A, typename S, typename C, typename = detail::requires_iterable<C>>
+histogram<A, S> reduce(const histogram<A, S>& h, const C& c) {
+  auto p = detail::make_reduction(h, c);
+  p.second(unsafe_access::storage(p.first), unsafe_access::storage(h));
+  return std::move(p.first);
 }
 
 template <typename A, typename S, typename... Ts>
@@ -0,0 +1,49 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_ALGORITHM_REDUCE_PARALLEL_HPP
+#define BOOST_HISTOGRAM_ALGORITHM_REDUCE_PARALLEL_HPP
+
+#include <boost/histogram/algorithm/reduce.hpp>
+#include <boost/histogram/detail/parallel.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <initializer_list>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace algorithm {
+
+/**
+  Like reduce, but shrinks and rebins in several threads.
+
+  Accepts the same arguments as reduce, preceded by the number of threads. If the number
+  of threads is zero, std::thread::hardware_concurrency() threads are used. The work is
+  split like in project_parallel, with one copy of the reduced storage per thread.
+*/
+template <typename A, typename S, typename C, typename = detail::requires_iterable<C>>
+histogram<A, S> reduce_parallel(const histogram<A, S>& h, unsigned nthreads,
+                                const C& c) {
+  auto p = detail::make_reduction(h, c);
+  detail::map_parallel(p.second, unsafe_access::storage(p.first),
+                       unsafe_access::storage(h), nthreads);
+  return std::move(p.first);
+}
+
+template <typename A, typename S, typename... Ts>
+histogram<A, S> reduce_parallel(const histogram<A, S>& h, unsigned nthreads,
+                                const reduce_option_type& t, Ts&&... ts) {
+  // this must be in one line, because any of the ts could be a temporary
+  return reduce_parallel(h, nthreads,
+                         std::initializer_list<reduce_option_type>{t, ts...});
+}
+
+} // namespace algorithm
+} // namespace histogram
+} // namespace boost
+
+#endif
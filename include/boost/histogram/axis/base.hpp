@@ -48,7 +48,7 @@ protected:
       : size_meta_(n, std::move(m)), opt_(opt) {
     if (size() == 0) { throw std::invalid_argument("bins > 0 required"); }
     const auto max_index =
-        static_cast<unsigned>(std::numeric_limits<int>::max() - static_cast<int>(opt_));
+        static_cast<unsigned>(std::numeric_limits<int>::max()) - detail::flow_bins(opt_);
     if (size() > max_index)
       throw std::invalid_argument(detail::cat("bins <= ", max_index, " required"));
   }
@@ -65,6 +65,9 @@ protected:
     return *this;
   }
 
+  // used by axes which grow
+  void set_size(unsigned n) noexcept { size_meta_.first() = n; }
+
   bool operator==(const base& rhs) const noexcept {
     return size() == rhs.size() && opt_ == rhs.opt_ &&
            detail::static_if<detail::is_equal_comparable<metadata_type>>(
@@ -12,14 +12,17 @@
 #include <boost/container/string.hpp> // default meta data
 #include <boost/histogram/axis/base.hpp>
 #include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/axis/traits.hpp>
 #include <boost/histogram/axis/value_bin_view.hpp>
 #include <boost/histogram/detail/buffer.hpp>
 #include <boost/histogram/detail/compressed_pair.hpp>
+#include <boost/histogram/detail/hash_index.hpp>
 #include <boost/histogram/detail/meta.hpp>
 #include <boost/histogram/histogram_fwd.hpp>
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace boost {
 namespace histogram {
@@ -30,7 +33,15 @@ namespace axis {
  * arguments in the constructor. There is an optional overflow bin
  * for this axis, which counts values that are not part of the set.
  * Binning is a O(n) operation for n values in the worst case and O(1) in
- * the best case. The value types must be equal-comparable.
+ * the best case. The value types must be equal-comparable. If the value
+ * type is hashable with std::hash and the axis has many values, a hash
+ * table is used instead and binning is a O(1) operation.
+ *
+ * With option_type::growth, values which are not in the set are appended
+ * as new bins when the axis is filled. Appending has amortized constant
+ * cost, because the values are stored with spare capacity. Put a growing
+ * category axis last in a histogram, then new bins are appended to the
+ * storage and the other bin counters keep their positions.
  */
 template <typename T, typename Allocator, typename MetaData>
 class category : public base<MetaData>,
@@ -52,8 +63,12 @@ public:
   template <typename It, typename = detail::requires_iterator<It>>
   category(It begin, It end, metadata_type m = metadata_type(),
            option_type o = option_type::overflow, allocator_type a = allocator_type())
-      : base_type(std::distance(begin, end), std::move(m), o), x_(nullptr, std::move(a)) {
+      : base_type(std::distance(begin, end), std::move(m), o)
+      , x_(nullptr, std::move(a))
+      , index_(x_.second()) {
     x_.first() = detail::create_buffer_from_iter(x_.second(), base_type::size(), begin);
+    capacity_ = base_type::size();
+    update_index();
   }
 
   /** Construct axis from iterable sequence of unique values.
@@ -81,9 +96,17 @@ public:
            option_type o = option_type::overflow, allocator_type a = allocator_type())
       : category(l.begin(), l.end(), std::move(m), o, std::move(a)) {}
 
+  /// Constructor used by algorithm::reduce to shrink (not for users).
+  category(const category& src, unsigned begin, unsigned end, unsigned merge)
+      : category(src.x_.first() + begin, src.x_.first() + end, src.metadata(),
+                 src.options(), src.x_.second()) {
+    if (merge > 1) throw std::invalid_argument("cannot merge bins of category axis");
+  }
+
   category() : x_(nullptr) {}
 
-  category(const category& o) : base_type(o), x_(o.x_) {
+  category(const category& o)
+      : base_type(o), x_(o.x_), index_(o.index_), capacity_(o.size()) {
     x_.first() =
         detail::create_buffer_from_iter(x_.second(), base_type::size(), o.x_.first());
   }
@@ -91,15 +114,18 @@ public:
   category& operator=(const category& o) {
     if (this != &o) {
       if (base_type::size() != o.size()) {
-        detail::destroy_buffer(x_.second(), x_.first(), base_type::size());
+        detail::destroy_buffer(x_.second(), x_.first(), base_type::size(), capacity_);
         base_type::operator=(o);
         x_ = o.x_;
         x_.first() =
             detail::create_buffer_from_iter(x_.second(), base_type::size(), o.x_.first());
+        capacity_ = base_type::size();
       } else {
         base_type::operator=(o);
         std::copy(o.x_.first(), o.x_.first() + base_type::size(), x_.first());
       }
+      // positions of values are the same, so the index can be copied as well
+      index_ = o.index_;
     }
     return *this;
   }
@@ -108,6 +134,8 @@ public:
     using std::swap;
     swap(static_cast<base_type&>(*this), static_cast<base_type&>(o));
     swap(x_, o.x_);
+    swap(index_, o.index_);
+    swap(capacity_, o.capacity_);
   }
 
   category& operator=(category&& o) {
@@ -115,19 +143,40 @@ public:
       using std::swap;
       swap(static_cast<base_type&>(*this), static_cast<base_type&>(o));
       swap(x_, o.x_);
+      swap(index_, o.index_);
+      swap(capacity_, o.capacity_);
     }
     return *this;
   }
 
-  ~category() { detail::destroy_buffer(x_.second(), x_.first(), base_type::size()); }
+  ~category() {
+    detail::destroy_buffer(x_.second(), x_.first(), base_type::size(), capacity_);
+  }
 
   /// Returns the bin index for the passed argument.
   int operator()(const value_type& x) const noexcept {
+    // Runs in hot loop, please measure impact of changes
     const auto begin = x_.first();
+    if (!index_.empty()) return index_.find(begin, base_type::size(), x);
     const auto end = begin + base_type::size();
     return std::distance(begin, std::find(begin, end, x));
   }
 
+  /** Returns the bin index for the passed argument and grows the axis if necessary.
+   *
+   * The axis only grows if it was constructed with option_type::growth. A value
+   * which is not in the axis is then appended as a new bin.
+   *
+   * \param x argument.
+   * \returns bin index of the argument and number of bins added below the previous
+   *          first bin, which is always zero for this axis.
+   */
+  std::pair<int, int> update(const value_type& x) {
+    const auto i = operator()(x);
+    if (i == static_cast<int>(base_type::size()) && traits::growth(*this)) push_back(x);
+    return {i, 0};
+  }
+
   /// Returns the value for the bin index (performs a range check).
   const value_type& value(unsigned idx) const {
     if (idx >= base_type::size()) throw std::out_of_range("category index out of range");
@@ -147,8 +196,58 @@ public:
   void serialize(Archive&, unsigned);
 
 private:
+  // below this number of values, a linear search is faster than hashing
+  static constexpr unsigned hash_threshold = 8;
+
+  void update_index() {
+    detail::static_if<detail::is_hashable<value_type>>(
+        [this](auto) {
+          if (base_type::size() >= hash_threshold)
+            index_.build(x_.first(), base_type::size());
+          else
+            index_.clear();
+        },
+        [](auto) {}, 0);
+  }
+
+  void push_back(const value_type& x) {
+    using AT = std::allocator_traits<allocator_type>;
+    auto& a = x_.second();
+    const unsigned n = base_type::size();
+    if (n == capacity_) {
+      // values are copied, so that the axis is unchanged if a copy throws
+      const unsigned c = std::max(2 * n, 4u);
+      const auto p = AT::allocate(a, c);
+      unsigned i = 0;
+      try {
+        for (; i < n; ++i) AT::construct(a, p + i, x_.first()[i]);
+        AT::construct(a, p + n, x);
+      } catch (...) {
+        while (i) AT::destroy(a, p + --i);
+        AT::deallocate(a, p, c);
+        throw;
+      }
+      detail::destroy_buffer(a, x_.first(), n, capacity_);
+      x_.first() = p;
+      capacity_ = c;
+    } else {
+      AT::construct(a, x_.first() + n, x);
+    }
+    base_type::set_size(n + 1);
+    detail::static_if<detail::is_hashable<value_type>>(
+        [this](auto) {
+          if (!index_.empty())
+            index_.append(x_.first(), base_type::size());
+          else if (base_type::size() >= hash_threshold)
+            index_.build(x_.first(), base_type::size());
+        },
+        [](auto) {}, 0);
+  }
+
   using pointer = typename std::allocator_traits<allocator_type>::pointer;
   detail::compressed_pair<pointer, allocator_type> x_;
+  detail::hash_index<allocator_type> index_;
+  unsigned capacity_ = 0; // number of values for which x_ has room
 };
 } // namespace axis
 } // namespace histogram
@@ -12,8 +12,10 @@
 #include <boost/histogram/axis/interval_bin_view.hpp>
 #include <boost/histogram/axis/iterator.hpp>
 #include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/simd_dispatch.hpp>
 #include <boost/histogram/histogram_fwd.hpp>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
@@ -30,6 +32,10 @@ constexpr double two_pi = 6.283185307179586;
  * The axis is circular and wraps around reaching the perimeter value.
  * It has no underflow bin and the overflow bin merely counts special
  * values like NaN and infinity. Binning is a O(1) operation.
+ *
+ * The bin index is computed by multiplying with the inverse of the perimeter, which is
+ * rounded. A value which is within a few ulp of a bin edge may therefore end up in
+ * the neighbouring bin.
  */
 template <typename RealType, typename MetaData>
 class circular : public base<MetaData>,
@@ -52,7 +58,8 @@ public:
       : base_type(n, std::move(m),
                   o == option_type::underflow_and_overflow ? option_type::overflow : o)
       , phase_(phase)
-      , delta_(perimeter / n) {
+      , delta_(perimeter / n)
+      , scale_(1 / perimeter) {
     if (!std::isfinite(phase) || !(perimeter > 0))
       throw std::invalid_argument("invalid phase or perimeter");
   }
@@ -61,7 +68,8 @@ public:
   circular(const circular& src, unsigned begin, unsigned end, unsigned merge)
       : base_type(src.size() / merge, src.metadata(), src.options())
       , phase_(src.phase_)
-      , delta_(src.delta_ * merge) {
+      , delta_(src.delta_ * merge)
+      , scale_(src.scale_) {
     if (!(begin == 0 && end == src.size()))
       throw std::invalid_argument("cannot shrink circular axis");
   }
@@ -70,12 +78,24 @@ public:
 
   /// Returns the bin index for the passed argument.
   int operator()(value_type x) const noexcept {
-    const auto z = std::floor((x - phase_) / delta_);
-    if (std::isfinite(z)) {
-      const auto i = static_cast<int>(z) % base_type::size();
-      return i + (i < 0) * base_type::size();
-    }
-    return base_type::size();
+    // Runs in hot loop, please measure impact of changes
+    return index(x, base_type::size());
+  }
+
+  /** Computes bin indices for n arguments, equivalent to calling operator() n times.
+   *
+   * \param x   pointer to n arguments.
+   * \param out pointer to n output indices.
+   * \param n   number of arguments.
+   */
+  void index_n(const value_type* x, int* out, std::size_t n) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    detail::simd_dispatch(
+        [this](const value_type* px, int* pout, std::size_t m) {
+          const value_type size = base_type::size();
+          for (std::size_t i = 0; i < m; ++i) pout[i] = index(px[i], size);
+        },
+        x, out, n);
   }
 
   /// Returns axis value for fractional index.
@@ -95,7 +115,23 @@ public:
   void serialize(Archive&, unsigned);
 
 private:
+  // branch-free, so that index_n is vectorized
+  int index(value_type x, value_type size) const noexcept {
+    // adding and subtracting the constant rounds to integer if |z| < shift / 3,
+    // std::floor is not vectorized by all compilers
+    constexpr auto shift = 3 / (2 * std::numeric_limits<value_type>::epsilon());
+    const auto z = (x - phase_) * scale_; // position in units of the perimeter
+    auto f = z - ((z + shift) - shift);   // in [-0.5, 0.5], NaN if x is not finite
+    // larger z have no fractional part worth mentioning, z - z keeps infinity as NaN
+    f = std::abs(z) >= shift / 3 ? z - z : f;
+    f += f < 0 ? 1 : 0;
+    const auto j = f * size;
+    // j == size for tiny negative f due to rounding, NaN goes to overflow
+    return static_cast<int>(j < size ? j : (j == j ? size - 1 : size));
+  }
+
   value_type phase_ = 0.0, delta_ = 1.0;
+  value_type scale_ = 1.0; // 1 / perimeter
 };
 } // namespace axis
 } // namespace histogram
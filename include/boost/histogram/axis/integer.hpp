@@ -13,8 +13,10 @@
 #include <boost/histogram/axis/iterator.hpp>
 #include <boost/histogram/axis/value_bin_view.hpp>
 #include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/simd_dispatch.hpp>
 #include <boost/histogram/histogram_fwd.hpp>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
@@ -61,9 +63,25 @@ public:
 
   /// Returns the bin index for the passed argument.
   int operator()(value_type x) const noexcept {
-    const auto i = static_cast<int>(std::floor(x - min_));
-    return i >= 0 ? (i > static_cast<int>(base_type::size()) ? base_type::size() : i)
-                  : -1;
+    // Runs in hot loop, please measure impact of changes
+    return index(std::is_integral<value_type>(), x, base_type::size());
+  }
+
+  /** Computes bin indices for n arguments, equivalent to calling operator() n times.
+   *
+   * \param x   pointer to n arguments.
+   * \param out pointer to n output indices.
+   * \param n   number of arguments.
+   */
+  void index_n(const value_type* x, int* out, std::size_t n) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    detail::simd_dispatch(
+        [this](const value_type* px, int* pout, std::size_t m) {
+          const int size = base_type::size();
+          for (std::size_t i = 0; i < m; ++i)
+            pout[i] = index(std::is_integral<value_type>(), px[i], size);
+        },
+        x, out, n);
   }
 
   /// Returns axis value for index.
@@ -93,6 +111,22 @@ public:
   void serialize(Archive&, unsigned);
 
 private:
+  // integer arguments: subtract and clamp, without conversion to floating point
+  int index(std::true_type, value_type x, int size) const noexcept {
+    using U = std::make_unsigned_t<value_type>;
+    // wraps around if x < min_, which is then handled by the last select
+    const auto u = static_cast<U>(static_cast<U>(x) - static_cast<U>(min_));
+    const int i = u < static_cast<U>(size) ? static_cast<int>(u) : size;
+    return x < min_ ? -1 : i;
+  }
+
+  // floating point arguments: truncation is floor for z >= 0, NaN goes to overflow
+  int index(std::false_type, value_type x, int size) const noexcept {
+    const auto z = x - min_;
+    const auto j = z < size ? (z >= 0 ? z : value_type(-1)) : value_type(size);
+    return static_cast<int>(j);
+  }
+
   value_type min_ = 0;
 };
 } // namespace axis
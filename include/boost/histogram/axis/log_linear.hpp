@@ -0,0 +1,207 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_LOG_LINEAR_HPP
+#define BOOST_HISTOGRAM_AXIS_LOG_LINEAR_HPP
+
+#include <boost/assert.hpp>
+#include <boost/container/string.hpp> // default meta data
+#include <boost/histogram/axis/base.hpp>
+#include <boost/histogram/axis/interval_bin_view.hpp>
+#include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/simd_dispatch.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace boost {
+namespace histogram {
+namespace axis {
+
+/** Axis for positive real values with log-linear bins, like in HdrHistogram.
+ *
+ * Each interval [2^k, 2^(k+1)) is split into the same number of sub-bins of equal
+ * width, so that the relative width of a bin is at most 1 / subbins. The bin index is
+ * computed from the exponent and the leading mantissa bits of the argument with a
+ * shift of its bit pattern, which is much faster than the log transform of the
+ * regular axis. Zero and negative values are counted in the underflow bin.
+ *
+ * \tparam RealType float or double.
+ */
+template <typename RealType, typename MetaData>
+class log_linear : public base<MetaData>,
+                   public iterator_mixin<log_linear<RealType, MetaData>> {
+  static_assert(std::is_floating_point<RealType>::value &&
+                    std::numeric_limits<RealType>::is_iec559 &&
+                    (sizeof(RealType) == 4 || sizeof(RealType) == 8),
+                "RealType must be float or double");
+  using base_type = base<MetaData>;
+  using value_type = RealType;
+  using metadata_type = MetaData;
+  using bits_type =
+      std::conditional_t<sizeof(RealType) == 4, std::uint32_t, std::uint64_t>;
+  // number of explicitly stored mantissa bits
+  static constexpr unsigned mantissa_bits = std::numeric_limits<RealType>::digits - 1;
+
+public:
+  /** Construct axis with sub-bins over range [min, max).
+   *
+   * The range is widened to the nearest bin edges.
+   *
+   * \param subbins  number of bins per factor of two, must be a power of two.
+   * \param min      low edge of first bin, must be positive.
+   * \param max      high edge of last bin.
+   * \param metadata description of the axis.
+   * \param options  extra bin options.
+   */
+  log_linear(unsigned subbins, value_type min, value_type max, metadata_type m = {},
+             option_type o = option_type::underflow_and_overflow)
+      : base_type(size_for(shift_for(subbins), min, max), std::move(m), o)
+      , first_(to_bits(min) >> shift_for(subbins))
+      , shift_(shift_for(subbins)) {
+    if (static_cast<unsigned>(o) & static_cast<unsigned>(option_type::growth))
+      throw std::invalid_argument("log_linear axis cannot grow");
+    set_range();
+  }
+
+  /** Constructor used by algorithm::reduce to shrink and rebin (not for users).
+   *
+   * Throws std::invalid_argument, unless merge is a power of two not larger than the
+   * number of sub-bins and the merged bins start on an edge of the coarser binning.
+   */
+  log_linear(const log_linear& src, unsigned begin, unsigned end, unsigned merge)
+      : base_type((end - begin) / merge, src.metadata(), src.options())
+      , first_((src.first_ + begin) / merge)
+      , shift_(src.shift_ + log2(merge)) {
+    BOOST_ASSERT((end - begin) % merge == 0);
+    if ((merge & (merge - 1)) != 0 || merge > src.subbins())
+      throw std::invalid_argument("merge must be a power of 2 and <= subbins");
+    if ((src.first_ + begin) % merge != 0)
+      throw std::invalid_argument("merged bins must start on an edge of coarser bins");
+    set_range();
+  }
+
+  log_linear() = default;
+
+  /// Returns the bin index for the passed argument.
+  int operator()(value_type x) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    if (x < lower_) return -1; // also for zero and negative values
+    if (x < upper_) return static_cast<int>((to_bits(x) >> shift_) - first_);
+    return base_type::size(); // also returned if x is NaN
+  }
+
+  /** Computes bin indices for n arguments, equivalent to calling operator() n times.
+   *
+   * \param x   pointer to n arguments.
+   * \param out pointer to n output indices.
+   * \param n   number of arguments.
+   */
+  void index_n(const value_type* x, int* out, std::size_t n) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    detail::simd_dispatch(
+        [this](const value_type* px, int* pout, std::size_t m) {
+          const int size = base_type::size();
+          for (std::size_t i = 0; i < m; ++i) {
+            // computed for all arguments, only used for those in range
+            const auto j = static_cast<int>((to_bits(px[i]) >> shift_) - first_);
+            pout[i] = px[i] < lower_ ? -1 : (px[i] < upper_ ? j : size);
+          }
+        },
+        x, out, n);
+  }
+
+  /// Returns axis value for fractional index, interpolates linearly within a bin.
+  value_type value(value_type i) const noexcept {
+    if (i < 0) return -std::numeric_limits<value_type>::infinity();
+    if (i > base_type::size()) return std::numeric_limits<value_type>::infinity();
+    const auto k = std::floor(i);
+    const auto a = edge(static_cast<bits_type>(k));
+    if (k == i) return a;
+    return a + (i - k) * (edge(static_cast<bits_type>(k) + 1) - a);
+  }
+
+  /// Access bin at index
+  auto operator[](int idx) const noexcept {
+    return interval_bin_view<log_linear>(idx, *this);
+  }
+
+  /// Returns the number of bins per factor of two.
+  unsigned subbins() const noexcept { return 1u << (mantissa_bits - shift_); }
+
+  bool operator==(const log_linear& o) const noexcept {
+    return base_type::operator==(o) && first_ == o.first_ && shift_ == o.shift_;
+  }
+
+  bool operator!=(const log_linear& o) const noexcept { return !operator==(o); }
+
+  template <class Archive>
+  void serialize(Archive&, unsigned);
+
+private:
+  static bits_type to_bits(value_type x) noexcept {
+    bits_type u;
+    std::memcpy(&u, &x, sizeof(u));
+    return u;
+  }
+
+  static value_type from_bits(bits_type u) noexcept {
+    value_type x;
+    std::memcpy(&x, &u, sizeof(x));
+    return x;
+  }
+
+  static unsigned log2(unsigned n) noexcept {
+    unsigned k = 0;
+    while (n >>= 1) ++k;
+    return k;
+  }
+
+  static unsigned shift_for(unsigned subbins) {
+    if (subbins == 0 || (subbins & (subbins - 1)) != 0)
+      throw std::invalid_argument("subbins must be a power of 2");
+    const auto k = log2(subbins);
+    if (k > mantissa_bits)
+      throw std::invalid_argument("subbins too large for floating point type");
+    return mantissa_bits - k;
+  }
+
+  static unsigned size_for(unsigned shift, value_type min, value_type max) {
+    if (!(min > 0 && min < max && max <= std::numeric_limits<value_type>::max()))
+      throw std::invalid_argument("0 < min < max required, max must be finite");
+    // positive floating point numbers are ordered like their bit patterns
+    const auto n = ((to_bits(max) - 1) >> shift) + 1 - (to_bits(min) >> shift);
+    if (n > static_cast<bits_type>(std::numeric_limits<int>::max()))
+      throw std::invalid_argument("too many bins");
+    return static_cast<unsigned>(n);
+  }
+
+  // low edge of bin k, the upper edge of the largest float is infinity
+  value_type edge(bits_type k) const noexcept {
+    return from_bits((first_ + k) << shift_);
+  }
+
+  void set_range() noexcept {
+    lower_ = edge(0);
+    upper_ = edge(base_type::size());
+  }
+
+  bits_type first_ = 0; // bit pattern of lower edge, shifted right by shift_
+  unsigned shift_ = 0;
+  value_type lower_ = 0, upper_ = 0; // derived from first_ and shift_
+};
+
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
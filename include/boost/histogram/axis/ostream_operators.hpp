@@ -13,8 +13,10 @@
 #include <boost/histogram/axis/category.hpp>
 #include <boost/histogram/axis/circular.hpp>
 #include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
 #include <boost/histogram/axis/interval_bin_view.hpp>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
 #include <boost/histogram/axis/value_bin_view.hpp>
 #include <boost/histogram/axis/variable.hpp>
 #include <boost/histogram/axis/variant.hpp>
@@ -89,11 +91,15 @@ namespace axis {
 template <typename C, typename T>
 std::basic_ostream<C, T>& operator<<(std::basic_ostream<C, T>& os,
                                      const axis::option_type o) {
-  switch (o) {
-    case axis::option_type::none: os << "none"; break;
-    case axis::option_type::overflow: os << "overflow"; break;
-    case axis::option_type::underflow_and_overflow: os << "underflow_and_overflow"; break;
+  switch (detail::flow_bins(o)) {
+    case 0: os << "none"; break;
+    case 1: os << "overflow"; break;
+    case 2: os << "underflow_and_overflow"; break;
   }
+  if (static_cast<unsigned>(o) & static_cast<unsigned>(axis::option_type::growth))
+    os << " | growth";
+  if (static_cast<unsigned>(o) & static_cast<unsigned>(axis::option_type::reciprocal))
+    os << " | reciprocal";
   return os;
 }
 
@@ -138,6 +144,28 @@ std::basic_ostream<C, T>& operator<<(std::basic_ostream<C, T>& os,
   return os;
 }
 
+template <typename C, typename T, unsigned N, typename B, typename E, option_type O,
+          typename M>
+std::basic_ostream<C, T>& operator<<(std::basic_ostream<C, T>& os,
+                                     const static_regular<N, B, E, O, M>& a) {
+  os << "static_regular(" << a.size() << ", " << a.value(0) << ", " << a.value(a.size());
+  detail::stream_metadata(os, a.metadata());
+  detail::stream_options(os, a.options());
+  os << ")";
+  return os;
+}
+
+template <typename C, typename T, typename... Ts>
+std::basic_ostream<C, T>& operator<<(std::basic_ostream<C, T>& os,
+                                     const log_linear<Ts...>& a) {
+  os << "log_linear(" << a.subbins() << ", " << a.value(0) << ", "
+     << a.value(a.size());
+  detail::stream_metadata(os, a.metadata());
+  detail::stream_options(os, a.options());
+  os << ")";
+  return os;
+}
+
 template <typename C, typename T, typename... Ts>
 std::basic_ostream<C, T>& operator<<(std::basic_ostream<C, T>& os,
                                      const circular<Ts...>& a) {
@@ -0,0 +1,157 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_STATIC_REGULAR_HPP
+#define BOOST_HISTOGRAM_AXIS_STATIC_REGULAR_HPP
+
+#include <boost/container/string.hpp> // default meta data
+#include <boost/histogram/axis/interval_bin_view.hpp>
+#include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/simd_dispatch.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ratio>
+#include <stdexcept>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace axis {
+/** Axis for equidistant intervals on the real line, configured at compile-time.
+ *
+ * Like regular with the identity transform, but the number of bins, the range, and
+ * the options are template parameters. The axis then only holds the metadata, and the
+ * compiler computes the bin index with constants, replacing the division by a
+ * multiplication and removing the loads of the axis parameters from memory. This is
+ * faster than the regular axis, if the binning is known at compile-time.
+ *
+ * The bin index is computed by multiplying with the rounded constant N / (stop - start),
+ * like regular with option_type::reciprocal, instead of dividing by the bin width. A
+ * value which is within a few ulp of a bin edge may therefore end up in the
+ * neighbouring bin of the one the default regular axis picks. For example, with 100
+ * bins over [-1, 1), the value -0.54 falls into bin 23 here and into bin 22 for
+ * regular. Use regular, if the bin of values exactly on an edge matters.
+ *
+ * \tparam N       number of bins.
+ * \tparam Start   low edge of first bin as std::ratio, e.g. std::ratio<-1, 2>.
+ * \tparam Stop    high edge of last bin as std::ratio.
+ * \tparam Options extra bin options.
+ */
+template <unsigned N, typename Start, typename Stop, option_type Options,
+          typename MetaData>
+class static_regular
+    : public iterator_mixin<static_regular<N, Start, Stop, Options, MetaData>> {
+  static_assert(N > 0, "bins > 0 required");
+  static_assert(N <= static_cast<unsigned>(std::numeric_limits<int>::max()) -
+                         detail::flow_bins(Options),
+                "number of bins too large");
+  static_assert(std::ratio_not_equal<Start, Stop>::value, "range is zero");
+  static_assert(!(static_cast<unsigned>(Options) &
+                  static_cast<unsigned>(option_type::growth)),
+                "static_regular cannot grow");
+  using metadata_type = MetaData;
+
+public:
+  /** Construct axis.
+   *
+   * \param metadata description of the axis.
+   */
+  explicit static_regular(metadata_type m = metadata_type()) : meta_(std::move(m)) {}
+
+  /// Constructor used by algorithm::reduce, throws unless range and bins are unchanged.
+  static_regular(const static_regular& src, unsigned begin, unsigned end,
+                 unsigned merge)
+      : static_regular(src) {
+    if (begin != 0 || end != N || merge != 1)
+      throw std::invalid_argument("cannot shrink or rebin static_regular axis");
+  }
+
+  /// Returns the bin index for the passed argument.
+  int operator()(double x) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    const auto z = (x - start()) * scale();
+    if (z < N) {
+      if (z >= 0)
+        return static_cast<int>(z);
+      else
+        return -1;
+    }
+    return N; // also returned if z is NaN
+  }
+
+  /** Computes bin indices for n arguments, equivalent to calling operator() n times.
+   *
+   * \param x   pointer to n arguments.
+   * \param out pointer to n output indices.
+   * \param n   number of arguments.
+   */
+  void index_n(const double* x, int* out, std::size_t n) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    detail::simd_dispatch(
+        [](const double* px, int* pout, std::size_t m) {
+          for (std::size_t i = 0; i < m; ++i) {
+            const auto z = (px[i] - start()) * scale();
+            // NaN fails both comparisons and ends up in the overflow bin
+            const auto j = z < N ? (z >= 0 ? z : -1.0) : static_cast<double>(N);
+            pout[i] = static_cast<int>(j);
+          }
+        },
+        x, out, n);
+  }
+
+  /// Returns axis value for fractional index.
+  double value(double i) const noexcept {
+    i /= N;
+    if (i < 0) return std::copysign(std::numeric_limits<double>::infinity(), -scale());
+    if (i > 1) return std::copysign(std::numeric_limits<double>::infinity(), scale());
+    return (1 - i) * start() + i * stop();
+  }
+
+  /// Access bin at index
+  auto operator[](int idx) const noexcept {
+    return interval_bin_view<static_regular>(idx, *this);
+  }
+
+  /// Returns the number of bins, without extra bins.
+  static constexpr unsigned size() noexcept { return N; }
+  /// Returns the options.
+  static constexpr option_type options() noexcept { return Options; }
+  /// Returns the metadata.
+  metadata_type& metadata() noexcept { return meta_; }
+  /// Returns the metadata (const version).
+  const metadata_type& metadata() const noexcept { return meta_; }
+
+  bool operator==(const static_regular& o) const noexcept {
+    return detail::static_if<detail::is_equal_comparable<metadata_type>>(
+        [&o](const auto& m) { return m == o.meta_; }, [](const auto&) { return true; },
+        meta_);
+  }
+
+  bool operator!=(const static_regular& o) const noexcept { return !operator==(o); }
+
+  template <class Archive>
+  void serialize(Archive&, unsigned);
+
+private:
+  static constexpr double start() noexcept {
+    return static_cast<double>(Start::num) / Start::den;
+  }
+  static constexpr double stop() noexcept {
+    return static_cast<double>(Stop::num) / Stop::den;
+  }
+  // inverse bin width, rounded once at compile-time
+  static constexpr double scale() noexcept { return N / (stop() - start()); }
+
+  metadata_type meta_;
+};
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -35,7 +35,12 @@ option_type options(const T& t) noexcept {
 
 template <typename T>
 unsigned extend(const T& t) noexcept {
-  return t.size() + static_cast<unsigned>(options(t));
+  return t.size() + detail::flow_bins(options(t));
+}
+
+template <typename T>
+bool growth(const T& t) noexcept {
+  return static_cast<unsigned>(options(t)) & static_cast<unsigned>(option_type::growth);
 }
 } // namespace traits
 } // namespace axis
@@ -15,6 +15,7 @@
 #include <boost/histogram/axis/iterator.hpp>
 #include <boost/histogram/detail/buffer.hpp>
 #include <boost/histogram/detail/compressed_pair.hpp>
+#include <boost/histogram/detail/edge_index.hpp>
 #include <boost/histogram/detail/meta.hpp>
 #include <boost/histogram/histogram_fwd.hpp>
 #include <cmath>
@@ -30,6 +31,8 @@ namespace axis {
  *
  * Binning is a O(log(N)) operation. If speed matters and the problem
  * domain allows it, prefer a regular axis, possibly with a transform.
+ * Axes with many bins use a search structure which is faster than a plain
+ * binary search. It approaches O(1) if the edges are spread evenly.
  */
 template <typename RealType, typename Allocator, typename MetaData>
 class variable : public base<MetaData>,
@@ -53,7 +56,8 @@ public:
            option_type o = option_type::underflow_and_overflow,
            allocator_type a = allocator_type())
       : base_type(begin == end ? 0 : std::distance(begin, end) - 1, std::move(m), o)
-      , x_(nullptr, std::move(a)) {
+      , x_(nullptr, std::move(a))
+      , index_(x_.second()) {
     using AT = std::allocator_traits<allocator_type>;
     x_.first() = AT::allocate(x_.second(), nx());
     try {
@@ -78,6 +82,7 @@ public:
       AT::deallocate(x_.second(), x_.first(), nx());
       throw;
     }
+    update_index();
   }
 
   /** Construct variable axis from iterable range of bin edges.
@@ -109,7 +114,9 @@ public:
 
   /// Constructor used by algorithm::reduce to shrink and rebin (not for users).
   variable(const variable& src, unsigned begin, unsigned end, unsigned merge)
-      : base_type((end - begin) / merge, src.metadata(), src.options()), x_(src.x_) {
+      : base_type((end - begin) / merge, src.metadata(), src.options())
+      , x_(src.x_)
+      , index_(x_.second()) {
     BOOST_ASSERT((end - begin) % merge == 0);
     using It = const detail::unqual<decltype(*src.x_.first())>*;
     struct skip_iterator {
@@ -124,12 +131,14 @@ public:
       bool operator==(const skip_iterator& rhs) const { return it == rhs.it; }
     } iter{src.x_.first() + begin, merge};
     x_.first() = detail::create_buffer_from_iter(x_.second(), nx(), iter);
+    update_index();
   }
 
   variable() : x_(nullptr) {}
 
-  variable(const variable& o) : base_type(o), x_(o.x_) {
+  variable(const variable& o) : base_type(o), x_(o.x_), index_(x_.second()) {
     x_.first() = detail::create_buffer_from_iter(x_.second(), nx(), o.x_.first());
+    update_index();
   }
 
   variable& operator=(const variable& o) {
@@ -143,6 +152,7 @@ public:
         x_.second() = o.x_.second();
         x_.first() = detail::create_buffer_from_iter(x_.second(), nx(), o.x_.first());
       }
+      update_index();
     }
     return *this;
   }
@@ -151,6 +161,7 @@ public:
     using std::swap;
     swap(static_cast<base_type&>(*this), static_cast<base_type&>(o));
     swap(x_, o.x_);
+    swap(index_, o.index_);
   }
 
   variable& operator=(variable&& o) {
@@ -158,6 +169,7 @@ public:
       using std::swap;
       swap(static_cast<base_type&>(*this), static_cast<base_type&>(o));
       swap(x_, o.x_);
+      swap(index_, o.index_);
     }
     return *this;
   }
@@ -166,7 +178,9 @@ public:
 
   /// Returns the bin index for the passed argument.
   int operator()(value_type x) const noexcept {
+    // Runs in hot loop, please measure impact of changes
     const auto p = x_.first();
+    if (!index_.empty()) return static_cast<int>(index_.upper_bound(p, nx(), x)) - 1;
     return std::upper_bound(p, p + nx(), x) - p - 1;
   }
 
@@ -194,9 +208,20 @@ public:
   void serialize(Archive&, unsigned);
 
 private:
+  // below this number of edges, the binary search is fast enough
+  static constexpr int index_threshold = 32;
+
+  void update_index() {
+    if (nx() >= index_threshold)
+      index_.build(x_.first(), nx());
+    else
+      index_.clear();
+  }
+
   int nx() const { return base_type::size() + 1; }
   using pointer = typename std::allocator_traits<allocator_type>::pointer;
   detail::compressed_pair<pointer, allocator_type> x_;
+  detail::edge_index<value_type, allocator_type> index_;
 };
 } // namespace axis
 } // namespace histogram
@@ -0,0 +1,197 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_CHUNKED_ADAPTIVE_STORAGE_HPP
+#define BOOST_HISTOGRAM_CHUNKED_ADAPTIVE_STORAGE_HPP
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/container/vector.hpp>
+#include <boost/histogram/adaptive_storage.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <boost/histogram/weight.hpp>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+namespace boost {
+namespace histogram {
+
+/** Adaptive storage which splits the bins into chunks of fixed size.
+
+  Each chunk is an adaptive_storage, which selects the counter type independently of the
+  other chunks. When a bin overflows, only the chunk which contains the bin is widened.
+  This keeps memory consumption low for histograms with many bins and a very skewed
+  distribution of counts, where a few hot bins would otherwise force the counters of all
+  bins to the widest type. The copy made during widening is also only as large as a
+  chunk. Chunks which were never filled allocate no memory.
+
+  The price is one more indirection per access, which makes fills a little slower if
+  the distribution of counts is not skewed.
+
+  \tparam Allocator allocator for bin counters and the array of chunks.
+  \tparam ChunkSize number of bins per chunk, must be a power of two.
+ */
+template <class Allocator, std::size_t ChunkSize>
+struct chunked_adaptive_storage {
+  static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+                "ChunkSize must be a power of two");
+
+  struct storage_tag {};
+  using allocator_type = Allocator;
+  using value_type = double;
+  using const_reference = double;
+
+  using chunk_type = adaptive_storage<Allocator>;
+  using chunk_allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<chunk_type>;
+
+  static constexpr std::size_t chunk_size = ChunkSize;
+
+  explicit chunked_adaptive_storage(const allocator_type& a = allocator_type())
+      : chunks(chunk_allocator_type(a)) {}
+
+  allocator_type get_allocator() const { return allocator_type(chunks.get_allocator()); }
+
+  void reset(std::size_t s) {
+    const auto a = get_allocator();
+    chunks.clear();
+    chunks.reserve((s + chunk_size - 1) / chunk_size);
+    for (std::size_t i = 0; i < s; i += chunk_size) {
+      chunks.emplace_back(a);
+      chunks.back().reset(std::min(ChunkSize, s - i));
+    }
+    size_ = s;
+  }
+
+  std::size_t size() const { return size_; }
+
+  // increase by one
+  void operator()(std::size_t i) {
+    BOOST_ASSERT(i < size());
+    chunks[i / chunk_size](i % chunk_size);
+  }
+
+  // increase by weight
+  template <typename T>
+  void operator()(std::size_t i, const weight_type<T>& x) {
+    BOOST_ASSERT(i < size());
+    chunks[i / chunk_size](i % chunk_size, x);
+  }
+
+  template <typename T>
+  void add(std::size_t i, const T& x) {
+    BOOST_ASSERT(i < size());
+    chunks[i / chunk_size].add(i % chunk_size, x);
+  }
+
+  const_reference operator[](std::size_t i) const {
+    return chunks[i / chunk_size][i % chunk_size];
+  }
+
+  // moves the counter at index i to index f(i) of a new storage with s counters, integral
+  // counters stay integral; f is called for each i in increasing order, must be
+  // injective and map into [0, s)
+  template <typename F>
+  void remap(std::size_t s, F&& f) {
+    chunked_adaptive_storage grown(get_allocator());
+    grown.reset(s);
+    for (std::size_t k = 0; k < chunks.size(); ++k)
+      chunk_type::apply(counter_mover(), chunks[k].buffer, grown, k * chunk_size, f);
+    *this = std::move(grown);
+  }
+
+  // inserts n zero counters before index pos, integral counters stay integral; if pos is
+  // close to the end, repeated insertions have amortized constant cost per counter
+  void insert_zeros(std::size_t pos, std::size_t n) {
+    BOOST_ASSERT(pos <= size());
+    const std::size_t first = pos / chunk_size;
+    const std::size_t offset = first * chunk_size;
+    const std::size_t s = size_ + n;
+    if (first + 1 == chunks.size() && s - offset <= chunk_size) {
+      chunks.back().insert_zeros(pos - offset, n);
+    } else {
+      // chunks from the one which contains pos are rebuilt
+      chunked_adaptive_storage tail(get_allocator());
+      tail.reset(s - offset);
+      const auto f = [pos, n, offset](std::size_t i) {
+        return (i < pos ? i : i + n) - offset;
+      };
+      for (std::size_t k = first; k < chunks.size(); ++k)
+        chunk_type::apply(counter_mover(), chunks[k].buffer, tail, k * chunk_size, f);
+      chunks.reserve(first + tail.chunks.size());
+      chunks.erase(chunks.begin() + first, chunks.end());
+      chunks.insert(chunks.end(), std::make_move_iterator(tail.chunks.begin()),
+                    std::make_move_iterator(tail.chunks.end()));
+    }
+    size_ = s;
+  }
+
+  bool operator==(const chunked_adaptive_storage& o) const {
+    if (size() != o.size()) return false;
+    // chunk layout only depends on size
+    for (std::size_t k = 0; k < chunks.size(); ++k)
+      if (!(chunks[k] == o.chunks[k])) return false;
+    return true;
+  }
+
+  template <typename T>
+  bool operator==(const T& o) const {
+    if (size() != o.size()) return false;
+    for (std::size_t i = 0; i < size(); ++i)
+      if (!(operator[](i) == o[i])) return false;
+    return true;
+  }
+
+  // precondition: storages have same size
+  chunked_adaptive_storage& operator+=(const chunked_adaptive_storage& o) {
+    BOOST_ASSERT(o.size() == size());
+    // self-adding is handled by adaptive_storage
+    for (std::size_t k = 0; k < chunks.size(); ++k) chunks[k] += o.chunks[k];
+    return *this;
+  }
+
+  // precondition: storages have same size
+  template <typename S>
+  chunked_adaptive_storage& operator+=(const S& rhs) {
+    const auto n = size();
+    BOOST_ASSERT(n == rhs.size());
+    for (std::size_t i = 0; i < n; ++i) add(i, rhs[i]);
+    return *this;
+  }
+
+  chunked_adaptive_storage& operator*=(const double x) {
+    for (auto&& c : chunks) c *= x;
+    return *this;
+  }
+
+  // adds the counters of one chunk to the storage s, at positions given by f
+  struct counter_mover {
+    template <typename T, typename Buffer, typename F>
+    void operator()(const T* tp, const Buffer& b, chunked_adaptive_storage& s,
+                    std::size_t offset, F& f) {
+      for (std::size_t i = 0; i < b.size; ++i) {
+        const auto k = f(offset + i);
+        if (tp[i] != 0) s.add(k, tp[i]);
+      }
+    }
+
+    template <typename Buffer, typename F>
+    void operator()(const void*, const Buffer& b, chunked_adaptive_storage&,
+                    std::size_t offset, F& f) {
+      for (std::size_t i = 0; i < b.size; ++i) f(offset + i);
+    }
+  };
+
+  boost::container::vector<chunk_type, chunk_allocator_type> chunks;
+
+private:
+  std::size_t size_ = 0;
+};
+} // namespace histogram
+} // namespace boost
+
+#endif
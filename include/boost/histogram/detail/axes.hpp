@@ -8,13 +8,17 @@
 #define BOOST_HISTOGRAM_DETAIL_AXES_HPP
 
 #include <algorithm>
+#include <array>
 #include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/container/static_vector.hpp>
 #include <boost/histogram/axis/traits.hpp>
 #include <boost/histogram/axis/variant.hpp>
 #include <boost/histogram/detail/meta.hpp>
 #include <boost/histogram/histogram_fwd.hpp>
 #include <boost/histogram/weight.hpp>
 #include <boost/mp11.hpp>
+#include <cstdint>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
@@ -184,9 +188,65 @@ auto make_sub_axes(const std::vector<Ts...>& t, Ns... ns) {
   return std::vector<Ts...>({t[ns]...}, t.get_allocator());
 }
 
+/// Size, extent, and stride of an axis in the storage
+struct axis_layout {
+  int size = 0;
+  int extent = 0;
+  std::size_t stride = 0;
+};
+
+template <typename T>
+struct axes_layout_container {
+  using type = boost::container::static_vector<axis_layout, axis::limit>;
+};
+
+template <typename... Ts>
+struct axes_layout_container<std::tuple<Ts...>> {
+  using type = std::array<axis_layout, sizeof...(Ts)>;
+};
+
+/*
+  Layout of the axes, cached by histogram and updated whenever the axes change. Filling
+  and bin access read sizes and strides from here instead of recomputing them from the
+  axes for every call, which costs a variant visit per axis for dynamic axes.
+*/
+template <typename T>
+class axes_layout {
+public:
+  axes_layout() = default;
+  explicit axes_layout(const T& axes) { reset(axes); }
+
+  void reset(const T& axes) {
+    resize(items_, axes_size(axes));
+    unsigned k = 0;
+    std::size_t stride = 1;
+    for_each_axis(axes, [&](const auto& a) {
+      auto& l = items_[k++];
+      l.size = static_cast<int>(a.size());
+      l.extent = static_cast<int>(axis::traits::extend(a));
+      l.stride = stride;
+      stride *= l.extent;
+    });
+  }
+
+  const axis_layout& operator[](std::size_t k) const noexcept { return items_[k]; }
+
+private:
+  template <std::size_t N>
+  static void resize(std::array<axis_layout, N>&, std::size_t) noexcept {}
+
+  template <typename C>
+  static void resize(C& c, std::size_t n) {
+    c.resize(n);
+  }
+
+  typename axes_layout_container<T>::type items_;
+};
+
 /// Index with an invalid state
 struct optional_index {
   std::size_t idx = 0;
+  // stride of next axis, or only a flag if the strides come from an axes_layout
   std::size_t stride = 1;
   operator bool() const { return stride > 0; }
   std::size_t operator*() const { return idx; }
@@ -202,23 +262,22 @@ inline void linearize(optional_index& out, const int axis_size, const int axis_s
   out.stride *= (j < axis_shape) * axis_shape;
 }
 
-template <typename... Ts, typename U>
-void linearize1(optional_index& out, const axis::variant<Ts...>& axis, const U& u) {
-  axis::visit([&](const auto& a) { linearize1(out, a, u); }, axis);
+inline void linearize(optional_index& out, const axis_layout& l, int j) noexcept {
+  BOOST_ASSERT_MSG(out.stride == 0 || (-1 <= j && j <= l.size),
+                   "index must be in bounds for this algorithm");
+  if (j < 0) j += (l.size + 2); // wrap around if j < 0
+  out.idx += j * l.stride;
+  out.stride *= j < l.extent; // set stride to 0, if j is invalid
 }
 
+// returns bin index, throws if u cannot be converted to the argument type of the axis
 template <typename A, typename U>
-void linearize1(optional_index& out, const A& axis, const U& u) {
+int axis_index(const A& axis, const U& u) {
   // protect against instantiation with wrong template argument
   using arg_t = arg_type<A>;
-  static_if<std::is_convertible<U, arg_t>>(
-      [&](const auto& u) {
-        const auto a_size = axis.size();
-        const auto a_shape = axis::traits::extend(axis);
-        const auto j = axis(u);
-        linearize(out, a_size, a_shape, j);
-      },
-      [&](const U&) {
+  return static_if<std::is_convertible<U, arg_t>>(
+      [&axis](const auto& u) -> int { return axis(u); },
+      [](const U&) -> int {
         throw std::invalid_argument(
             detail::cat(boost::core::demangled_name(BOOST_CORE_TYPEID(A)),
                         ": cannot convert argument of type ",
@@ -228,12 +287,32 @@ void linearize1(optional_index& out, const A& axis, const U& u) {
       u);
 }
 
-template <typename T>
-void linearize2(optional_index& out, const T& axis, const int j) {
-  const auto a_size = static_cast<int>(axis.size());
-  const auto a_shape = axis::traits::extend(axis);
-  out.stride *= (-1 <= j && j <= a_size); // set stride to 0, if j is invalid
-  linearize(out, a_size, a_shape, j);
+template <typename... Ts, typename U>
+void linearize1(optional_index& out, const axis::variant<Ts...>& axis, const U& u) {
+  axis::visit([&](const auto& a) { linearize1(out, a, u); }, axis);
+}
+
+template <typename A, typename U>
+void linearize1(optional_index& out, const A& axis, const U& u) {
+  const auto j = axis_index(axis, u);
+  linearize(out, axis.size(), axis::traits::extend(axis), j);
+}
+
+// like linearize1, but reads size and stride of the axis from the layout
+template <typename... Ts, typename U>
+void linearize1(optional_index& out, const axis_layout& l,
+                const axis::variant<Ts...>& axis, const U& u) {
+  linearize(out, l, axis::visit([&u](const auto& a) { return axis_index(a, u); }, axis));
+}
+
+template <typename A, typename U>
+void linearize1(optional_index& out, const axis_layout& l, const A& axis, const U& u) {
+  linearize(out, l, axis_index(axis, u));
+}
+
+inline void linearize2(optional_index& out, const axis_layout& l, const int j) {
+  out.stride *= (-1 <= j && j <= l.size); // set stride to 0, if j is invalid
+  linearize(out, l, j);
 }
 
 // special case: histogram::operator(tuple(1, 2)) is called on 1d histogram with axis
@@ -244,41 +323,321 @@ void linearize2(optional_index& out, const T& axis, const int j) {
 //   (axis::variant provides generic call interface and hides concrete interface),
 //   so we throw at runtime if incompatible argument is passed (e.g. 3d tuple)
 template <unsigned Offset, unsigned N, typename T, typename U>
-optional_index args_to_index(const std::tuple<T>& axes, const U& args) {
+optional_index args_to_index(const std::tuple<T>& axes,
+                             const axes_layout<std::tuple<T>>& layout, const U& args) {
   optional_index idx;
   if (N > 1) {
-    linearize1(idx, std::get<0>(axes), sub_tuple<Offset, N>(args));
+    linearize1(idx, layout[0], std::get<0>(axes), sub_tuple<Offset, N>(args));
   } else {
-    linearize1(idx, std::get<0>(axes), std::get<Offset>(args));
+    linearize1(idx, layout[0], std::get<0>(axes), std::get<Offset>(args));
   }
   return idx;
 }
 
 template <unsigned Offset, unsigned N, typename T0, typename T1, typename... Ts,
           typename U>
-optional_index args_to_index(const std::tuple<T0, T1, Ts...>& axes, const U& args) {
+optional_index args_to_index(const std::tuple<T0, T1, Ts...>& axes,
+                             const axes_layout<std::tuple<T0, T1, Ts...>>& layout,
+                             const U& args) {
   static_assert(sizeof...(Ts) + 2 == N, "number of arguments != histogram rank");
   optional_index idx;
-  mp11::mp_for_each<mp11::mp_iota_c<N>>(
-      [&](auto I) { linearize1(idx, std::get<I>(axes), std::get<(Offset + I)>(args)); });
+  mp11::mp_for_each<mp11::mp_iota_c<N>>([&](auto I) {
+    linearize1(idx, layout[I], std::get<I>(axes), std::get<(Offset + I)>(args));
+  });
   return idx;
 }
 
 // overload for dynamic axes
 template <unsigned Offset, unsigned N, typename T, typename U>
-optional_index args_to_index(const T& axes, const U& args) {
+optional_index args_to_index(const T& axes, const axes_layout<T>& layout,
+                             const U& args) {
+  const unsigned m = axes.size();
+  optional_index idx;
+  if (m == 1 && N > 1)
+    linearize1(idx, layout[0], axes[0], sub_tuple<Offset, N>(args));
+  else {
+    if (m != N) throw std::invalid_argument("number of arguments != histogram rank");
+    mp11::mp_for_each<mp11::mp_iota_c<N>>([&](auto I) {
+      linearize1(idx, layout[I], axes[I], std::get<(Offset + I)>(args));
+    });
+  }
+  return idx;
+}
+
+template <typename T>
+struct has_growing_axis_impl;
+
+// true if any axis type in T has the update method, T is an axis or container of axes
+template <typename T>
+using has_growing_axis = typename has_growing_axis_impl<T>::type;
+
+template <typename T>
+using has_growing_axis_value = has_growing_axis<typename T::value_type>;
+
+template <typename T>
+struct has_growing_axis_impl {
+  using type = mp11::mp_eval_if_c<!is_vector_like<T>::value, has_method_update<T>,
+                                  has_growing_axis_value, T>;
+};
+
+template <typename... Ts>
+struct has_growing_axis_impl<axis::variant<Ts...>> {
+  using type = mp11::mp_any_of<mp11::mp_list<unqual<Ts>...>, has_method_update>;
+};
+
+template <typename... Ts>
+struct has_growing_axis_impl<std::tuple<Ts...>> {
+  using type = mp11::mp_any<has_growing_axis<Ts>...>;
+};
+
+// true if any axis was constructed with option_type::growth
+template <typename T>
+bool has_growth(const T& axes) {
+  bool r = false;
+  for_each_axis(axes, [&r](const auto& a) { r |= axis::traits::growth(a); });
+  return r;
+}
+
+/*
+  Axes which grow change the layout of the storage. When axis k grows, its extent before
+  the growth is recorded, and the number of bins added below its first bin is
+  accumulated. Afterwards, storage_grow moves the counters to their new positions.
+*/
+struct growth_record {
+  static_assert(axis::limit <= 64, "axis::limit too large");
+  std::uint64_t grown = 0; // bit k is set if axis k grew
+  int extent[axis::limit];
+  int shift[axis::limit];
+
+  void add(unsigned k, int old_extent, int added_below) {
+    const auto bit = static_cast<std::uint64_t>(1) << k;
+    if (!(grown & bit)) {
+      grown |= bit;
+      extent[k] = old_extent;
+      shift[k] = 0;
+    }
+    shift[k] += added_below;
+  }
+};
+
+// true if non-const axis A can grow and accepts arguments of type U
+template <typename A, typename U>
+using can_update = mp11::mp_and<mp11::mp_not<std::is_const<A>>, has_method_update<A>,
+                                std::is_convertible<U, arg_type<A>>>;
+
+// returns bin index, records growth of axis k in g
+template <typename A, typename U>
+int update(growth_record& g, unsigned k, A& axis, const U& u) {
+  const int old_extent = axis::traits::extend(axis);
+  const auto r = axis.update(u);
+  if (static_cast<int>(axis::traits::extend(axis)) != old_extent)
+    g.add(k, old_extent, r.second);
+  return r.first;
+}
+
+// first pass, does not change the axis: sets grow to true if a value is outside of the
+// normal bins of an axis which can grow, then the second pass with growth_record must be
+// done
+template <typename A, typename U>
+bool linearize_grow1(optional_index& out, const axis_layout& l, const A& axis,
+                     const U& u) {
+  const auto j = axis_index(axis, u);
+  linearize(out, l, j);
+  return (j < 0 || j >= l.size) && axis::traits::growth(axis);
+}
+
+template <typename... Ts, typename U>
+void linearize_grow(optional_index& out, bool& grow, unsigned, const axis_layout& l,
+                    const axis::variant<Ts...>& axis, const U& u) {
+  // returning the flag instead of setting it in the visitor is faster
+  grow |= axis::visit([&](const auto& a) { return linearize_grow1(out, l, a, u); },
+                      axis);
+}
+
+template <typename A, typename U>
+void linearize_grow(optional_index& out, bool& grow, unsigned, const axis_layout& l,
+                    const A& axis, const U& u) {
+  grow |= linearize_grow1(out, l, axis, u);
+}
+
+// second pass, axes grow as needed and their layout is not used, because it changes
+template <typename A, typename U>
+void linearize_grow(optional_index& out, growth_record& g, unsigned k,
+                    const axis_layout&, A& axis, const U& u);
+
+template <typename... Ts, typename U>
+void linearize_grow(optional_index& out, growth_record& g, unsigned k,
+                    const axis_layout& l, axis::variant<Ts...>& axis, const U& u) {
+  // visiting a non-const variant is slower, axis is not const so the cast is safe
+  const auto& caxis = axis;
+  axis::visit(
+      [&](const auto& a) {
+        linearize_grow(out, g, k, l, const_cast<unqual<decltype(a)>&>(a), u);
+      },
+      caxis);
+}
+
+template <typename A, typename U>
+void linearize_grow(optional_index& out, growth_record& g, unsigned k,
+                    const axis_layout&, A& axis, const U& u) {
+  static_if<can_update<A, U>>(
+      [&](auto& axis) {
+        if (axis::traits::growth(axis)) {
+          const auto j = update(g, k, axis, u);
+          linearize(out, axis.size(), axis::traits::extend(axis), j);
+        } else {
+          linearize1(out, axis, u);
+        }
+      },
+      [&](auto& axis) { linearize1(out, axis, u); }, axis);
+}
+
+// like args_to_index, G is bool for the first and growth_record for the second pass
+template <unsigned Offset, unsigned N, typename G, typename T, typename U>
+optional_index args_to_index_grow(G& g, std::tuple<T>& axes,
+                                  const axes_layout<std::tuple<T>>& layout,
+                                  const U& args) {
+  optional_index idx;
+  if (N > 1) {
+    linearize_grow(idx, g, 0, layout[0], std::get<0>(axes), sub_tuple<Offset, N>(args));
+  } else {
+    linearize_grow(idx, g, 0, layout[0], std::get<0>(axes), std::get<Offset>(args));
+  }
+  return idx;
+}
+
+template <unsigned Offset, unsigned N, typename G, typename T0, typename T1,
+          typename... Ts, typename U>
+optional_index args_to_index_grow(G& g, std::tuple<T0, T1, Ts...>& axes,
+                                  const axes_layout<std::tuple<T0, T1, Ts...>>& layout,
+                                  const U& args) {
+  static_assert(sizeof...(Ts) + 2 == N, "number of arguments != histogram rank");
+  optional_index idx;
+  mp11::mp_for_each<mp11::mp_iota_c<N>>([&](auto I) {
+    linearize_grow(idx, g, I, layout[I], std::get<I>(axes),
+                   std::get<(Offset + I)>(args));
+  });
+  return idx;
+}
+
+// overload for dynamic axes
+template <unsigned Offset, unsigned N, typename G, typename T, typename U>
+optional_index args_to_index_grow(G& g, T& axes, const axes_layout<T>& layout,
+                                  const U& args) {
   const unsigned m = axes.size();
   optional_index idx;
   if (m == 1 && N > 1)
-    linearize1(idx, axes[0], sub_tuple<Offset, N>(args));
+    linearize_grow(idx, g, 0, layout[0], axes[0], sub_tuple<Offset, N>(args));
   else {
     if (m != N) throw std::invalid_argument("number of arguments != histogram rank");
-    mp11::mp_for_each<mp11::mp_iota_c<N>>(
-        [&](auto I) { linearize1(idx, axes[I], std::get<(Offset + I)>(args)); });
+    mp11::mp_for_each<mp11::mp_iota_c<N>>([&](auto I) {
+      linearize_grow(idx, g, I, layout[I], axes[I], std::get<(Offset + I)>(args));
+    });
   }
   return idx;
 }
 
+// vector-like storages are resized in place, which has amortized constant cost per new
+// counter; then only the flow bins of the last axis, which follow its n old bins, are
+// moved behind its new_n bins, each flow bin is a block of stride counters; storages
+// with insert_zeros, like adaptive_storage, insert the new bins in front of the flow bins
+template <typename S>
+bool storage_append(S& storage, std::size_t new_size, int n, int new_n, int extent,
+                    std::size_t stride) {
+  return static_if<is_vector_like<S>>(
+      [&](auto& storage) {
+        using value_type = typename S::value_type;
+        storage.resize(new_size);
+        for (int j = extent - 1; j >= n; --j) {
+          const auto src = j * stride;
+          const auto dst = (j - n + new_n) * stride;
+          for (std::size_t m = 0; m < stride; ++m) {
+            storage[dst + m] = storage[src + m];
+            storage[src + m] = value_type();
+          }
+        }
+        return true;
+      },
+      [&](auto& storage) {
+        return static_if<has_method_insert_zeros<S>>(
+            [&](auto& storage) {
+              storage.insert_zeros(n * stride, (new_n - n) * stride);
+              return true;
+            },
+            [](auto&) { return false; }, storage);
+      },
+      storage);
+}
+
+// returns storage of the same type without counters, which uses the allocator of s if
+// the storage can be constructed from it; avoids copying the counters of s
+template <typename S>
+S empty_storage(const S& s) {
+  return static_if<has_allocator_ctor<S>>(
+      [](const auto& s) { return S(s.get_allocator()); }, [](const auto&) { return S(); },
+      s);
+}
+
+// moves bin counters to their new positions after the axes grew as recorded in g
+template <typename S, typename T>
+void storage_grow(S& storage, const T& axes, const growth_record& g) {
+  BOOST_ASSERT(g.grown);
+  struct item {
+    int extent, size, new_size, shift;
+    std::size_t stride;
+  } items[axis::limit];
+  unsigned rank = 0;
+  std::size_t stride = 1;
+  for_each_axis(axes, [&](const auto& a) {
+    auto& d = items[rank];
+    const bool grown = g.grown & (static_cast<std::uint64_t>(1) << rank);
+    d.extent = grown ? g.extent[rank] : static_cast<int>(axis::traits::extend(a));
+    d.size = d.extent - static_cast<int>(flow_bins(axis::traits::options(a)));
+    d.new_size = a.size();
+    d.shift = grown ? g.shift[rank] : 0;
+    d.stride = stride;
+    stride *= axis::traits::extend(a);
+    ++rank;
+  });
+
+  // if only the last axis grew and only above its last bin, the new bins and the moved
+  // flow bins of that axis come after all other counters, which keep their positions
+  const auto& last = items[rank - 1];
+  const bool append = g.grown == static_cast<std::uint64_t>(1) << (rank - 1) &&
+                      last.shift == 0;
+  if (append && storage_append(storage, stride, last.size, last.new_size, last.extent,
+                               last.stride))
+    return;
+
+  // maps index of a counter in the old storage to its index in the grown storage, must
+  // be called for all indices in increasing order
+  int j[axis::limit] = {};
+  const auto f = [&](std::size_t) {
+    std::size_t k = 0;
+    for (unsigned r = 0; r < rank; ++r) {
+      const auto& d = items[r];
+      // normal bins are shifted, overflow and underflow bin follow the last bin
+      const int jr = j[r] < d.size ? j[r] + d.shift : j[r] - d.size + d.new_size;
+      k += jr * d.stride;
+    }
+    // increment multi-dimensional index like an odometer
+    for (unsigned r = 0; r < rank && ++j[r] == items[r].extent; ++r) j[r] = 0;
+    return k;
+  };
+
+  // storages which can remap their counters keep the counter type
+  static_if<has_method_remap<S>>(
+      [&](auto& storage) { storage.remap(stride, f); },
+      [&](auto& storage) {
+        auto grown = empty_storage(storage);
+        grown.reset(stride);
+        for (std::size_t i = 0, n = storage.size(); i < n; ++i)
+          grown.add(f(i), storage[i]);
+        storage = std::move(grown);
+      },
+      storage);
+}
+
 template <typename U>
 constexpr std::pair<int, int> weight_sample_indices() {
   if (is_weight<U>::value) return std::make_pair(0, -1);
@@ -339,14 +698,40 @@ void fill_storage_impl(mp11::mp_int<Iw>, mp11::mp_int<Is>, S& storage, std::size
                     std::get<Is>(args).value);
 }
 
+// kept out of line, so that filling histograms whose axes do not grow stays fast
+template <unsigned I, unsigned N, typename S, typename T, typename U>
+BOOST_NOINLINE optional_index args_to_index_and_grow(S& storage, T& axes,
+                                                     axes_layout<T>& layout,
+                                                     const U& args) {
+  growth_record g;
+  const auto idx = args_to_index_grow<I, N>(g, axes, layout, args);
+  if (g.grown) {
+    storage_grow(storage, axes, g);
+    layout.reset(axes);
+  }
+  return idx;
+}
+
 template <typename S, typename T, typename... Us>
-void fill_impl(S& storage, const T& axes, const std::tuple<Us...>& args) {
+void fill_impl(S& storage, T& axes, axes_layout<T>& layout,
+               const std::tuple<Us...>& args) {
   constexpr std::pair<int, int> iws = weight_sample_indices<Us...>();
   constexpr unsigned n = sizeof...(Us) - (iws.first > -1) - (iws.second > -1);
   constexpr unsigned offset = (iws.first == 0 || iws.second == 0)
                                   ? (iws.first == 1 || iws.second == 1 ? 2 : 1)
                                   : 0;
-  optional_index idx = args_to_index<offset, n>(axes, args);
+  optional_index idx = static_if<has_growing_axis<T>>(
+      [&storage, &layout, &args](auto& axes) {
+        bool grow = false;
+        const auto idx = args_to_index_grow<offset, n>(grow, axes, layout, args);
+        if (BOOST_UNLIKELY(grow))
+          return args_to_index_and_grow<offset, n>(storage, axes, layout, args);
+        return idx;
+      },
+      [&layout, &args](const auto& axes) {
+        return args_to_index<offset, n>(axes, layout, args);
+      },
+      axes);
   if (idx) {
     fill_storage_impl(mp11::mp_int<iws.first>(), mp11::mp_int<iws.second>(), storage,
                       *idx, args);
@@ -354,12 +739,13 @@ void fill_impl(S& storage, const T& axes, const std::tuple<Us...>& args) {
 }
 
 template <typename A, typename... Us>
-optional_index at_impl(const A& axes, const std::tuple<Us...>& args) {
+optional_index at_impl(const A& axes, const axes_layout<A>& layout,
+                       const std::tuple<Us...>& args) {
   if (axes_size(axes) != sizeof...(Us))
     throw std::invalid_argument("number of arguments != histogram rank");
   optional_index idx;
   mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Us)>>([&](auto I) {
-    linearize2(idx, axis_get<I>(axes), static_cast<int>(std::get<I>(args)));
+    linearize2(idx, layout[I], static_cast<int>(std::get<I>(args)));
   });
   return idx;
 }
@@ -88,9 +88,10 @@ typename std::allocator_traits<Allocator>::pointer create_buffer_from_iter(
   return ptr;
 }
 
+// destroys the first n elements of a buffer with room for capacity elements
 template <typename Allocator>
 void destroy_buffer(Allocator& a, typename std::allocator_traits<Allocator>::pointer p,
-                    std::size_t n) {
+                    std::size_t n, std::size_t capacity) {
   if (!p)
     return;
   using AT = std::allocator_traits<Allocator>;
@@ -100,7 +101,13 @@ void destroy_buffer(Allocator& a, typename std::allocator_traits<Allocator>::poi
     --it;
     AT::destroy(a, it);
   }
-  AT::deallocate(a, p, n);
+  AT::deallocate(a, p, capacity);
+}
+
+template <typename Allocator>
+void destroy_buffer(Allocator& a, typename std::allocator_traits<Allocator>::pointer p,
+                    std::size_t n) {
+  destroy_buffer(a, p, n, n);
 }
 
 } // namespace detail
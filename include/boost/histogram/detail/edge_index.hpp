@@ -0,0 +1,208 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_EDGE_INDEX_HPP
+#define BOOST_HISTOGRAM_DETAIL_EDGE_INDEX_HPP
+
+#include <algorithm>
+#include <boost/config.hpp>
+#include <boost/histogram/detail/buffer.hpp>
+#include <boost/histogram/detail/compressed_pair.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/*
+  Search structure for a sorted array of bin edges, which computes the same result as
+  std::upper_bound in fewer steps. Depending on the distribution of the edges, one of
+  two layouts is used.
+
+  grid: The range of edges is split into a uniform grid. For every grid cell, a table
+  holds the number of edges in all cells below. A lookup computes the cell of the
+  argument and compares only with the few edges in that cell. Since the computation of
+  the cell is monotonic in the argument, edges in lower cells are always smaller and
+  edges in higher cells always larger than the argument, so the result is exact. This
+  is used when no cell holds more than grid_max_occupancy edges.
+
+  tree: The edges are copied in Eytzinger order (breadth-first order of the implicit
+  binary search tree), which is searched without branches. The children of a node are
+  adjacent in memory, so that grandchildren several levels down can be prefetched.
+*/
+template <typename T, typename Allocator>
+class edge_index {
+  using value_allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+  using int_allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<int>;
+  using value_pointer = typename std::allocator_traits<value_allocator_type>::pointer;
+  using int_pointer = typename std::allocator_traits<int_allocator_type>::pointer;
+
+  static constexpr std::size_t grid_max_occupancy = 4;
+
+public:
+  explicit edge_index(const Allocator& a = Allocator()) : i_(nullptr, a) {}
+
+  edge_index(edge_index&& o) : edge_index(o.i_.second()) { swap(*this, o); }
+
+  edge_index& operator=(edge_index&& o) {
+    if (this != &o) swap(*this, o);
+    return *this;
+  }
+
+  // copies are not needed, the owner rebuilds the index from its own edges
+  edge_index(const edge_index&) = delete;
+  edge_index& operator=(const edge_index&) = delete;
+
+  ~edge_index() { clear(); }
+
+  friend void swap(edge_index& a, edge_index& b) noexcept {
+    using std::swap;
+    swap(a.i_, b.i_);
+    swap(a.v_, b.v_);
+    swap(a.ni_, b.ni_);
+    swap(a.nv_, b.nv_);
+    swap(a.ncell_, b.ncell_);
+    swap(a.x0_, b.x0_);
+    swap(a.x1_, b.x1_);
+    swap(a.scale_, b.scale_);
+  }
+
+  bool empty() const noexcept { return ni_ == 0; }
+
+  void clear() noexcept {
+    int_allocator_type ia(i_.second());
+    destroy_buffer(ia, i_.first(), ni_);
+    i_.first() = nullptr;
+    ni_ = 0;
+    value_allocator_type va(i_.second());
+    destroy_buffer(va, v_, nv_);
+    v_ = nullptr;
+    nv_ = 0;
+  }
+
+  /// Build index for sorted array of n edges
+  template <typename It>
+  void build(It edges, std::size_t n) {
+    clear();
+    if (n < 2) return;
+    static_if<std::is_floating_point<T>>(
+        [this, n](auto edges) { this->build_grid(edges, n); }, [](auto) {}, edges);
+    if (empty()) build_tree(edges, n);
+  }
+
+  /// Returns std::upper_bound(edges, edges + n, x) - edges
+  template <typename It>
+  std::size_t upper_bound(It edges, std::size_t n, T x) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    return nv_ ? upper_bound_tree(n, x) : upper_bound_grid(edges, n, x);
+  }
+
+private:
+  template <typename It>
+  void build_grid(It edges, std::size_t n) {
+    x0_ = edges[0];
+    x1_ = edges[n - 1];
+    ncell_ = 2 * n;
+    scale_ = ncell_ / (x1_ - x0_);
+    if (!std::isfinite(scale_)) return;
+
+    int_allocator_type ia(i_.second());
+    // table[c] = number of edges in cells below c
+    auto table = create_buffer(ia, ncell_ + 1, 0);
+    for (std::size_t i = 0; i < n; ++i) ++table[cell(edges[i]) + 1];
+    std::size_t max_occupancy = 0;
+    for (std::size_t c = 1; c <= ncell_; ++c) {
+      max_occupancy = std::max(max_occupancy, static_cast<std::size_t>(table[c]));
+      table[c] += table[c - 1];
+    }
+    if (max_occupancy > grid_max_occupancy) {
+      destroy_buffer(ia, table, ncell_ + 1);
+      return;
+    }
+    i_.first() = table;
+    ni_ = ncell_ + 1;
+  }
+
+  std::size_t cell(T x) const noexcept {
+    // monotonic in x, clamped to the last cell to protect against round-off
+    const auto c = static_cast<std::size_t>((x - x0_) * scale_);
+    return std::min(c, ncell_ - 1);
+  }
+
+  template <typename It>
+  std::size_t upper_bound_grid(It edges, std::size_t n, T x) const noexcept {
+    if (x < x0_) return 0;
+    if (!(x < x1_)) return n; // also handles NaN like std::upper_bound
+    const auto table = i_.first();
+    const auto c = cell(x);
+    std::size_t k = table[c];
+    const std::size_t end = table[c + 1];
+    for (std::size_t i = k; i < end; ++i) k += !(x < edges[i]);
+    return k;
+  }
+
+  template <typename It>
+  void build_tree(It edges, std::size_t n) {
+    int_allocator_type ia(i_.second());
+    value_allocator_type va(i_.second());
+    // node k has children 2k and 2k + 1, node 0 is not used
+    i_.first() = create_buffer(ia, n + 1, 0);
+    ni_ = n + 1;
+    v_ = create_buffer(va, n + 1, edges[0]);
+    nv_ = n + 1;
+    std::size_t i = 0;
+    fill_tree(edges, i, 1);
+  }
+
+  template <typename It>
+  void fill_tree(It edges, std::size_t& i, std::size_t k) {
+    if (k >= nv_) return;
+    fill_tree(edges, i, 2 * k);
+    v_[k] = edges[i];
+    i_.first()[k] = static_cast<int>(i);
+    ++i;
+    fill_tree(edges, i, 2 * k + 1);
+  }
+
+  std::size_t upper_bound_tree(std::size_t n, T x) const noexcept {
+    const auto v = v_;
+    std::size_t k = 1;
+    while (k <= n) {
+#if defined(BOOST_GCC) || defined(BOOST_CLANG)
+      // fetch the cache line with the descendants a few levels down
+      __builtin_prefetch(&v[0] + k * prefetch_stride());
+#endif
+      // same comparison as std::upper_bound, so that NaN goes to the end
+      k = 2 * k + !(x < v[k]);
+    }
+    // strip the right turns made after the last left turn
+    while (k & 1) k >>= 1;
+    k >>= 1;
+    return k ? static_cast<std::size_t>(i_.first()[k]) : n;
+  }
+
+  static constexpr std::size_t prefetch_stride() noexcept {
+    return 64 / sizeof(T) > 1 ? 64 / sizeof(T) : 1;
+  }
+
+  compressed_pair<int_pointer, Allocator> i_;
+  value_pointer v_ = nullptr;
+  std::size_t ni_ = 0, nv_ = 0, ncell_ = 0;
+  T x0_ = 0, x1_ = 0, scale_ = 0;
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,108 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_FAST_MATH_HPP
+#define BOOST_HISTOGRAM_DETAIL_FAST_MATH_HPP
+
+#include <boost/config.hpp>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+/*
+  Approximations of log and exp for batch kernels. They are branch-free and use only
+  floating point and integer arithmetic which compilers vectorize, unlike the calls to
+  std::log and std::exp. Arguments outside of the supported range return NaN, callers
+  then fall back to the exact function.
+
+  The absolute error of the result y is below fast_math_tolerance * (1 + |y|).
+*/
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+BOOST_ATTRIBUTE_UNUSED static constexpr double fast_math_tolerance = 1e-12;
+
+inline double bits_to_double(std::uint64_t u) noexcept {
+  double x;
+  std::memcpy(&x, &u, sizeof(x));
+  return x;
+}
+
+inline std::uint64_t double_to_bits(double x) noexcept {
+  std::uint64_t u;
+  std::memcpy(&u, &x, sizeof(x));
+  return u;
+}
+
+/// Natural logarithm for normal positive finite x, NaN otherwise
+inline double fast_log(double x) noexcept {
+  // Compilers turn selects of computed values back into branches and then do not
+  // vectorize the loop, the code therefore selects only integers and constants.
+  const auto u = double_to_bits(x);
+  // mantissa m in [1, 2), moved to [sqrt(1/2), sqrt(2)) by decrementing its exponent
+  auto mu = (u & 0x000fffffffffffff) | 0x3ff0000000000000;
+  const std::uint64_t high = mu > 0x3ff6a09e667f3bcd; // bits of sqrt(2)
+  const auto m = bits_to_double(mu - (high << 52));
+  // exponent as a double, avoids an int64 to double conversion; 0x4330... is the bit
+  // pattern of 2^52 = 4503599627370496, whose mantissa then holds the integer
+  const auto e =
+      bits_to_double(((u >> 52) + high) | 0x4330000000000000) - 4503599627370496.0 - 1023;
+  // log(m) = 2 atanh(s) with |s| < 0.172, series truncated after s^17
+  const auto s = (m - 1) / (m + 1);
+  const auto s2 = s * s;
+  auto p = 1.0 / 17;
+  p = p * s2 + 1.0 / 15;
+  p = p * s2 + 1.0 / 13;
+  p = p * s2 + 1.0 / 11;
+  p = p * s2 + 1.0 / 9;
+  p = p * s2 + 1.0 / 7;
+  p = p * s2 + 1.0 / 5;
+  p = p * s2 + 1.0 / 3;
+  const auto log_m = 2 * s + 2 * s * s2 * p;
+  // ln(2) split into a part with a short mantissa, so that e * ln2_hi is exact
+  const auto y =
+      e * 6.93147180369123816490e-01 + (log_m + e * 1.90821492927058770002e-10);
+  const bool valid = (x >= std::numeric_limits<double>::min()) &
+                     (x <= std::numeric_limits<double>::max());
+  return y + (valid ? 0.0 : std::numeric_limits<double>::quiet_NaN());
+}
+
+/// Exponential for |x| < 708, the result is then a normal number, NaN otherwise
+inline double fast_exp(double x) noexcept {
+  // x = n ln(2) + r with integer n and |r| <= ln(2) / 2
+  // 1.5 * 2^52, adding it rounds to integer, held in low bits
+  constexpr double shift = 6755399441055744.0;
+  const auto k = x * 1.4426950408889634 + shift;
+  const auto n = k - shift;
+  const auto r = (x - n * 6.93147180369123816490e-01) - n * 1.90821492927058770002e-10;
+  // Taylor series of exp(r), truncated after r^13
+  auto p = 1.0 / 6227020800;
+  p = p * r + 1.0 / 479001600;
+  p = p * r + 1.0 / 39916800;
+  p = p * r + 1.0 / 3628800;
+  p = p * r + 1.0 / 362880;
+  p = p * r + 1.0 / 40320;
+  p = p * r + 1.0 / 5040;
+  p = p * r + 1.0 / 720;
+  p = p * r + 1.0 / 120;
+  p = p * r + 1.0 / 24;
+  p = p * r + 1.0 / 6;
+  p = p * r + 0.5;
+  p = p * r + 1;
+  p = p * r + 1;
+  // 2^n from the low bits of k, which hold n in two's complement
+  const auto y = p * bits_to_double((double_to_bits(k) + 1023) << 52);
+  const bool valid = (x > -708) & (x < 708);
+  return y + (valid ? 0.0 : std::numeric_limits<double>::quiet_NaN());
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
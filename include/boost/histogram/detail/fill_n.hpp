@@ -0,0 +1,479 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_FILL_N_HPP
+#define BOOST_HISTOGRAM_DETAIL_FILL_N_HPP
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/core/typeinfo.hpp>
+#include <boost/histogram/detail/axes.hpp>
+#include <boost/histogram/detail/cat.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/weight.hpp>
+#include <boost/mp11.hpp>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+  Bulk fills of histograms with at least this many bins are done in two phases. The
+  linear indices of many samples are buffered and grouped by storage block, before the
+  storage is incremented block by block. Scattered increments of a storage much larger
+  than the cache miss it for nearly every sample. Define this before including any
+  header of the library to change the threshold.
+*/
+#ifndef BOOST_HISTOGRAM_SORTED_FILL_THRESHOLD
+#define BOOST_HISTOGRAM_SORTED_FILL_THRESHOLD (1 << 24)
+#endif
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/*
+  Bulk fills are processed in blocks of this many samples. For each block, the indices
+  are computed axis by axis over the whole block, before the storage is touched. The
+  index buffer of one block should fit comfortably into the L1 cache.
+*/
+BOOST_ATTRIBUTE_UNUSED static constexpr std::size_t fill_n_block_size = 1 << 9;
+
+template <typename T>
+auto span_data(const T& t) -> decltype(t.data()) {
+  return t.data();
+}
+
+template <typename T, std::size_t N>
+const T* span_data(const T (&t)[N]) {
+  return t;
+}
+
+template <typename T>
+std::size_t span_size(const T& t) {
+  return static_cast<std::size_t>(std::distance(std::begin(t), std::end(t)));
+}
+
+template <typename T>
+std::size_t span_size(const weight_type<T>& t) {
+  return span_size(t.value);
+}
+
+template <typename T>
+decltype(auto) span_data(const weight_type<T>& t) {
+  return span_data(t.value);
+}
+
+template <typename A, typename U>
+[[noreturn]] void throw_argument_not_convertible() {
+  throw std::invalid_argument(
+      detail::cat(boost::core::demangled_name(BOOST_CORE_TYPEID(A)),
+                  ": cannot convert argument of type ",
+                  boost::core::demangled_name(BOOST_CORE_TYPEID(U)), " to ",
+                  boost::core::demangled_name(BOOST_CORE_TYPEID(arg_type<A>))));
+}
+
+/*
+  Linear indices of a block are accumulated in a plain array. Samples which fall into
+  a non-existing bin are marked by setting the index to invalid_index. Since the total
+  number of bins is much smaller than invalid_index, adding the contribution of the
+  remaining axes cannot move a marked index back into the valid range.
+*/
+BOOST_ATTRIBUTE_UNUSED static constexpr std::size_t invalid_index =
+    ~static_cast<std::size_t>(0) / 2;
+
+inline void linearize_n_impl(std::size_t& out, const std::size_t stride,
+                             const int axis_size, const int axis_shape, int j) noexcept {
+  if (j < 0) j += (axis_size + 2); // wrap around if j < 0
+  out = j < axis_shape ? out + j * stride : invalid_index;
+}
+
+template <typename A, typename T>
+void linearize_n(std::size_t* out, const std::size_t stride, std::size_t n, const A& axis,
+                 const T* values);
+
+// variant is visited once per block, the inner loop then runs on the concrete axis type
+template <typename... Ts, typename T>
+void linearize_n(std::size_t* out, const std::size_t stride, std::size_t n,
+                 const axis::variant<Ts...>& axis, const T* values) {
+  axis::visit([&](const auto& a) { linearize_n(out, stride, n, a, values); }, axis);
+}
+
+// overload for axes with a batch method, which is faster than calling the axis per value
+template <typename A, typename T>
+void linearize_n(std::true_type, std::size_t* out, const std::size_t stride,
+                 std::size_t n, const A& axis, const T* values) {
+  int j[fill_n_block_size];
+  axis.index_n(values, j, n);
+  const int a_size = axis.size();
+  const int a_shape = axis::traits::extend(axis);
+  for (std::size_t i = 0; i < n; ++i)
+    linearize_n_impl(out[i], stride, a_size, a_shape, j[i]);
+}
+
+template <typename A, typename T>
+void linearize_n(std::false_type, std::size_t* out, const std::size_t stride,
+                 std::size_t n, const A& axis, const T* values) {
+  static_if<std::is_convertible<T, arg_type<A>>>(
+      [&](const auto& axis) {
+        // size and extend are loop invariants, but the compiler cannot prove it
+        const int a_size = axis.size();
+        const int a_shape = axis::traits::extend(axis);
+        for (std::size_t i = 0; i < n; ++i)
+          linearize_n_impl(out[i], stride, a_size, a_shape, axis(values[i]));
+      },
+      [](const A&) { throw_argument_not_convertible<A, T>(); }, axis);
+}
+
+template <typename A, typename T>
+void linearize_n(std::size_t* out, const std::size_t stride, std::size_t n, const A& axis,
+                 const T* values) {
+  BOOST_ASSERT(n <= fill_n_block_size);
+  linearize_n(has_method_index_n<A, T>(), out, stride, n, axis, values);
+}
+
+template <unsigned Offset, unsigned N, typename... Ts, typename U>
+void args_to_index_n(std::size_t* out, std::size_t start, std::size_t n,
+                     const std::tuple<Ts...>& axes, const U& args) {
+  static_assert(sizeof...(Ts) == N, "number of arguments != histogram rank");
+  std::size_t stride = 1;
+  mp11::mp_for_each<mp11::mp_iota_c<N>>([&](auto I) {
+    const auto& a = std::get<I>(axes);
+    linearize_n(out, stride, n, a, span_data(std::get<(Offset + I)>(args)) + start);
+    stride *= axis::traits::extend(a);
+  });
+}
+
+// overload for dynamic axes, rank was already checked by caller
+template <unsigned Offset, unsigned N, typename T, typename U>
+void args_to_index_n(std::size_t* out, std::size_t start, std::size_t n, const T& axes,
+                     const U& args) {
+  std::size_t stride = 1;
+  mp11::mp_for_each<mp11::mp_iota_c<N>>([&](auto I) {
+    const auto& a = axes[I];
+    linearize_n(out, stride, n, a, span_data(std::get<(Offset + I)>(args)) + start);
+    stride *= axis::traits::extend(a);
+  });
+}
+
+// bin indices instead of values, indices outside of [-1, size] are invalid
+template <typename A, typename T>
+void linearize_index_n(std::size_t* out, const std::size_t stride, std::size_t n,
+                       const A& axis, const T* indices) {
+  const int a_size = axis.size();
+  const int a_shape = axis::traits::extend(axis);
+  for (std::size_t i = 0; i < n; ++i) {
+    auto j = static_cast<int>(indices[i]);
+    if (j < -1 || j > a_size) j = a_shape;
+    linearize_n_impl(out[i], stride, a_size, a_shape, j);
+  }
+}
+
+template <unsigned Offset, unsigned N, typename... Ts, typename U>
+void indices_to_index_n(std::size_t* out, std::size_t start, std::size_t n,
+                        const std::tuple<Ts...>& axes, const U& args) {
+  static_assert(sizeof...(Ts) == N, "number of arguments != histogram rank");
+  std::size_t stride = 1;
+  mp11::mp_for_each<mp11::mp_iota_c<N>>([&](auto I) {
+    const auto& a = std::get<I>(axes);
+    linearize_index_n(out, stride, n, a, span_data(std::get<(Offset + I)>(args)) + start);
+    stride *= axis::traits::extend(a);
+  });
+}
+
+// overload for dynamic axes, rank was already checked by caller
+template <unsigned Offset, unsigned N, typename T, typename U>
+void indices_to_index_n(std::size_t* out, std::size_t start, std::size_t n,
+                        const T& axes, const U& args) {
+  std::size_t stride = 1;
+  mp11::mp_for_each<mp11::mp_iota_c<N>>([&](auto I) {
+    const auto& a = axes[I];
+    linearize_index_n(out, stride, n, a, span_data(std::get<(Offset + I)>(args)) + start);
+    stride *= axis::traits::extend(a);
+  });
+}
+
+// computes linear indices from values
+template <unsigned Offset, unsigned N, typename T, typename U>
+void to_index_n(std::false_type, std::size_t* out, std::size_t start, std::size_t n,
+                const T& axes, const U& args) {
+  args_to_index_n<Offset, N>(out, start, n, axes, args);
+}
+
+// computes linear indices from bin indices
+template <unsigned Offset, unsigned N, typename T, typename U>
+void to_index_n(std::true_type, std::size_t* out, std::size_t start, std::size_t n,
+                const T& axes, const U& args) {
+  indices_to_index_n<Offset, N>(out, start, n, axes, args);
+}
+
+// overload for storages with a batch method, invalid indices are removed in place
+template <typename S>
+void fill_storage_n(std::true_type, S& storage, std::size_t* idx, std::size_t n) {
+  const auto size = storage.size();
+  std::size_t m = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    idx[m] = idx[i];
+    m += idx[i] < size;
+  }
+  storage.increment_n(idx, m);
+}
+
+template <typename S>
+void fill_storage_n(std::false_type, S& storage, std::size_t* idx, std::size_t n) {
+  const auto size = storage.size();
+  for (std::size_t i = 0; i < n; ++i)
+    if (idx[i] < size) storage(idx[i]);
+}
+
+template <typename S>
+void fill_storage_n(S& storage, std::size_t* idx, std::size_t n) {
+  fill_storage_n(has_method_increment_n<S>(), storage, idx, n);
+}
+
+template <typename S, typename W>
+void fill_storage_n(S& storage, const std::size_t* idx, std::size_t n, const W* w) {
+  const auto size = storage.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    // must be const lvalue, so that storages pick the overload for weight_type
+    const auto wi = weight(w[i]);
+    if (idx[i] < size) storage(idx[i], wi);
+  }
+}
+
+BOOST_ATTRIBUTE_UNUSED static constexpr std::size_t fill_n_sort_threshold =
+    BOOST_HISTOGRAM_SORTED_FILL_THRESHOLD;
+
+// samples buffered for one partition, a multiple of fill_n_block_size
+BOOST_ATTRIBUTE_UNUSED static constexpr std::size_t fill_n_sort_size = 1 << 18;
+
+// the storage is split into 2^fill_n_sort_bits blocks of consecutive bins
+BOOST_ATTRIBUTE_UNUSED static constexpr unsigned fill_n_sort_bits = 10;
+
+// stands in for the weights of an unweighted fill
+struct no_weight {};
+
+template <typename S>
+void fill_storage_n(S& storage, std::size_t* idx, std::size_t n, const no_weight*) {
+  fill_storage_n(storage, idx, n);
+}
+
+/*
+  Copies n keys and weights to out and wout, grouped by the storage block of the key
+  with one pass of a radix sort. The order within a block is kept, so that weights are
+  added in the original order. Weights are not copied, if w is null. A full sort of the
+  keys costs more than it saves, blocks are small enough to stay in the L2 cache.
+*/
+template <typename W>
+void radix_partition_n(const std::size_t* key, const W* w, std::size_t* out, W* wout,
+                       std::size_t n, unsigned shift) {
+  std::size_t count[std::size_t(1) << fill_n_sort_bits] = {};
+  for (std::size_t i = 0; i < n; ++i) ++count[key[i] >> shift];
+  std::size_t sum = 0;
+  for (auto&& c : count) {
+    const auto ci = c;
+    c = sum;
+    sum += ci;
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto j = count[key[i] >> shift]++;
+    out[j] = key[i];
+    if (w) wout[j] = w[i];
+  }
+}
+
+template <unsigned Offset, typename U>
+auto weight_data(const U& args) {
+  return static_if_c<(Offset == 1)>(
+      [](const auto& args) { return span_data(std::get<0>(args)); },
+      [](const auto&) { return static_cast<const no_weight*>(nullptr); }, args);
+}
+
+// two-phase fill of the samples in [begin, end), see fill_n_sort_threshold
+template <unsigned Offset, unsigned N, typename S, typename T, typename U,
+          typename IsIndex>
+void fill_n_sorted(S& storage, const T& axes, const U& args, std::size_t begin,
+                   std::size_t end, IsIndex is_index) {
+  const std::size_t size = storage.size();
+  unsigned bits = 0;
+  while (bits < 64 && ((size - 1) >> bits) > 0) ++bits;
+  const unsigned shift = bits > fill_n_sort_bits ? bits - fill_n_sort_bits : 0;
+
+  const auto w = weight_data<Offset>(args);
+  using W = std::remove_const_t<std::remove_pointer_t<decltype(w)>>;
+  const auto buffer_size = std::min(fill_n_sort_size, end - begin);
+  std::vector<std::size_t> key(2 * buffer_size);
+  std::vector<W> wkey(w ? 2 * buffer_size : 0);
+  W* const wptr = w ? wkey.data() : nullptr;
+
+  for (std::size_t start = begin; start < end; start += fill_n_sort_size) {
+    const auto m = std::min(fill_n_sort_size, end - start);
+    // compute indices block by block, invalid indices are removed in place
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < m; i += fill_n_block_size) {
+      const auto mi = std::min(fill_n_block_size, m - i);
+      const auto out = key.data() + k;
+      std::fill(out, out + mi, 0);
+      to_index_n<Offset, N>(is_index, out, start + i, mi, axes, args);
+      for (std::size_t j = 0; j < mi; ++j) {
+        key[k] = out[j];
+        if (w) wptr[k] = w[start + i + j];
+        k += out[j] < size;
+      }
+    }
+    const auto sorted = key.data() + buffer_size;
+    const auto wsorted = w ? wptr + buffer_size : nullptr;
+    radix_partition_n(key.data(), wptr, sorted, wsorted, k, shift);
+    fill_storage_n(storage, sorted, k, static_cast<const W*>(wsorted));
+  }
+}
+
+template <typename... Ts>
+std::size_t span_size_check(const std::tuple<Ts...>& args) {
+  const std::size_t n = span_size(std::get<0>(args));
+  mp11::tuple_for_each(args, [n](const auto& x) {
+    if (span_size(x) != n) throw std::invalid_argument("spans must have equal size");
+  });
+  return n;
+}
+
+// checks arguments and returns number of samples
+template <typename T, typename... Us>
+std::size_t fill_n_check(const T& axes, const std::tuple<Us...>& args) {
+  constexpr unsigned offset = is_weight<mp11::mp_first<mp11::mp_list<Us...>>>::value;
+  if (axes_size(axes) != sizeof...(Us) - offset)
+    throw std::invalid_argument("number of arguments != histogram rank");
+  return span_size_check(args);
+}
+
+// fills samples in [begin, end), arguments must have been checked with fill_n_check;
+// if IsIndex is true, the arguments are bin indices instead of values
+template <typename S, typename T, typename... Us, typename IsIndex = std::false_type>
+void fill_n_range(S& storage, const T& axes, const std::tuple<Us...>& args,
+                  std::size_t begin, std::size_t end, IsIndex is_index = {}) {
+  // weight is optional and must be the first argument, sample is not supported
+  constexpr unsigned offset = is_weight<mp11::mp_first<mp11::mp_list<Us...>>>::value;
+  constexpr unsigned n = sizeof...(Us) - offset;
+
+  if (storage.size() >= fill_n_sort_threshold && end - begin > fill_n_block_size)
+    return fill_n_sorted<offset, n>(storage, axes, args, begin, end, is_index);
+
+  std::size_t idx[fill_n_block_size];
+  for (std::size_t start = begin; start < end; start += fill_n_block_size) {
+    const auto m = std::min(fill_n_block_size, end - start);
+    std::fill(idx, idx + m, 0);
+    to_index_n<offset, n>(is_index, idx, start, m, axes, args);
+    static_if_c<(offset == 1)>(
+        [&](const auto& args) {
+          fill_storage_n(storage, idx, m, span_data(std::get<0>(args)) + start);
+        },
+        [&](const auto&) { fill_storage_n(storage, idx, m); }, args);
+  }
+}
+
+template <typename A, typename T>
+void update_n(growth_record& g, unsigned k, A& axis, const T* values, std::size_t n);
+
+template <typename... Ts, typename T>
+void update_n(growth_record& g, unsigned k, axis::variant<Ts...>& axis, const T* values,
+              std::size_t n) {
+  // see linearize_grow
+  const auto& caxis = axis;
+  axis::visit(
+      [&](const auto& a) {
+        update_n(g, k, const_cast<unqual<decltype(a)>&>(a), values, n);
+      },
+      caxis);
+}
+
+// grows axis so that it includes all values, inconvertible values are handled later
+template <typename A, typename T>
+void update_n(growth_record& g, unsigned k, A& axis, const T* values, std::size_t n) {
+  static_if<can_update<A, T>>(
+      [&](auto& axis) {
+        if (!axis::traits::growth(axis)) return;
+        const int old_extent = axis::traits::extend(axis);
+        int shift = 0;
+        for (std::size_t i = 0; i < n; ++i) shift += axis.update(values[i]).second;
+        const int extent = axis::traits::extend(axis);
+        if (extent != old_extent) g.add(k, old_extent, shift);
+      },
+      [](auto&) {}, axis);
+}
+
+// layout is reset as soon as the axes grew, so that it stays valid if filling throws
+template <typename S, typename T, typename... Us>
+void fill_n_impl(S& storage, T& axes, axes_layout<T>& layout,
+                 const std::tuple<Us...>& args) {
+  constexpr unsigned offset = is_weight<mp11::mp_first<mp11::mp_list<Us...>>>::value;
+  constexpr unsigned n = sizeof...(Us) - offset;
+  const std::size_t size = fill_n_check(axes, args);
+  static_if<has_growing_axis<T>>(
+      [&](auto& axes) {
+        // axes grow first to include all values, so that the bin indices computed for
+        // the whole span are valid
+        if (!has_growth(axes)) return;
+        growth_record g;
+        mp11::mp_for_each<mp11::mp_iota_c<n>>([&](auto I) {
+          update_n(g, I, axis_get<I>(axes), span_data(std::get<(offset + I)>(args)),
+                   size);
+        });
+        if (g.grown) {
+          storage_grow(storage, axes, g);
+          layout.reset(axes);
+        }
+      },
+      [](const auto&) {}, axes);
+  fill_n_range(storage, axes, args, 0, size);
+}
+
+template <typename S, typename T, typename... Us>
+void fill_n_by_index_impl(S& storage, const T& axes, const std::tuple<Us...>& args) {
+  fill_n_range(storage, axes, args, 0, fill_n_check(axes, args), std::true_type());
+}
+
+// args are an optional weight span and a span of linear indices
+template <typename S, typename... Us>
+void fill_n_by_linear_index_impl(S& storage, const std::tuple<Us...>& args) {
+  constexpr unsigned offset = is_weight<mp11::mp_first<mp11::mp_list<Us...>>>::value;
+  static_assert(sizeof...(Us) == offset + 1, "expected one span of linear indices");
+  const std::size_t size = span_size_check(args);
+  const auto indices = span_data(std::get<offset>(args));
+
+  std::size_t idx[fill_n_block_size];
+  for (std::size_t start = 0; start < size; start += fill_n_block_size) {
+    const auto m = std::min(fill_n_block_size, size - start);
+    std::copy(indices + start, indices + start + m, idx);
+    static_if_c<(offset == 1)>(
+        [&](const auto& args) {
+          fill_storage_n(storage, idx, m, span_data(std::get<0>(args)) + start);
+        },
+        [&](const auto&) { fill_storage_n(storage, idx, m); }, args);
+  }
+}
+
+// writes linear index for each sample to out, invalid_index if sample is not in a bin
+template <typename T, typename... Us>
+void index_n_impl(std::size_t* out, const T& axes, const std::tuple<Us...>& args) {
+  static_assert(!is_weight<mp11::mp_first<mp11::mp_list<Us...>>>::value,
+                "weights are not allowed here");
+  constexpr unsigned n = sizeof...(Us);
+  const std::size_t size = fill_n_check(axes, args);
+  for (std::size_t start = 0; start < size; start += fill_n_block_size) {
+    const auto m = std::min(fill_n_block_size, size - start);
+    std::fill(out + start, out + start + m, 0);
+    args_to_index_n<0, n>(out + start, start, m, axes, args);
+  }
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
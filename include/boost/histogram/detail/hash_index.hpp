@@ -0,0 +1,150 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_HASH_INDEX_HPP
+#define BOOST_HISTOGRAM_DETAIL_HASH_INDEX_HPP
+
+#include <algorithm>
+#include <boost/histogram/detail/buffer.hpp>
+#include <boost/histogram/detail/compressed_pair.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/*
+  Open-addressing hash table which maps values to their position in an external array.
+
+  The table only stores positions, the values are looked up in the external array, so
+  it has to be rebuilt whenever the values in the array change. Collisions are resolved
+  by linear probing. The table is kept at most half full, so that unsuccessful searches,
+  which happen for every value that ends up in the overflow bin, stay short.
+*/
+template <typename Allocator>
+class hash_index {
+  using allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<int>;
+  using pointer = typename std::allocator_traits<allocator_type>::pointer;
+
+public:
+  explicit hash_index(const Allocator& a = Allocator())
+      : t_(nullptr, allocator_type(a)) {}
+
+  hash_index(const hash_index& o) : t_(o.t_), size_(o.size_), shift_(o.shift_) {
+    t_.first() = create_buffer_from_iter(t_.second(), size_, o.t_.first());
+  }
+
+  hash_index& operator=(const hash_index& o) {
+    if (this != &o) {
+      if (size_ != o.size_) {
+        destroy_buffer(t_.second(), t_.first(), size_);
+        t_.first() = nullptr;
+        size_ = 0;
+        t_.first() = create_buffer_from_iter(t_.second(), o.size_, o.t_.first());
+        size_ = o.size_;
+      } else {
+        std::copy(o.t_.first(), o.t_.first() + size_, t_.first());
+      }
+      shift_ = o.shift_;
+    }
+    return *this;
+  }
+
+  hash_index(hash_index&& o) : hash_index(o.t_.second()) { swap(*this, o); }
+
+  hash_index& operator=(hash_index&& o) {
+    if (this != &o) swap(*this, o);
+    return *this;
+  }
+
+  ~hash_index() { destroy_buffer(t_.second(), t_.first(), size_); }
+
+  friend void swap(hash_index& a, hash_index& b) noexcept {
+    using std::swap;
+    swap(a.t_, b.t_);
+    swap(a.size_, b.size_);
+    swap(a.shift_, b.shift_);
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  void clear() noexcept {
+    destroy_buffer(t_.second(), t_.first(), size_);
+    t_.first() = nullptr;
+    size_ = 0;
+  }
+
+  /// Build table for the first n values of array
+  template <typename It>
+  void build(It values, std::size_t n) {
+    std::size_t size = 4;
+    unsigned bits = 2;
+    while (size < 2 * n) {
+      size *= 2;
+      ++bits;
+    }
+    clear();
+    t_.first() = create_buffer(t_.second(), size, -1);
+    size_ = size;
+    shift_ = 64 - bits;
+    for (std::size_t i = 0; i < n; ++i) insert(values, static_cast<int>(i));
+  }
+
+  /// Add value at position n - 1 after it was appended to the array of n values
+  template <typename It>
+  void append(It values, std::size_t n) {
+    // rebuilding doubles the table, so appending has amortized constant cost
+    if (2 * n > size_)
+      build(values, n);
+    else
+      insert(values, static_cast<int>(n - 1));
+  }
+
+  /// Returns position of x in the array or n, if x is not in the array
+  template <typename It, typename T>
+  int find(It values, std::size_t n, const T& x) const noexcept {
+    const auto t = t_.first();
+    const std::size_t mask = size_ - 1;
+    for (std::size_t k = slot(x);; k = (k + 1) & mask) {
+      const int i = t[k];
+      if (i < 0) return static_cast<int>(n);
+      if (values[i] == x) return i;
+    }
+  }
+
+private:
+  template <typename T>
+  std::size_t slot(const T& x) const noexcept {
+    // Fibonacci hashing, spreads the bits of weak hashes like std::hash<int>
+    const std::uint64_t h = std::hash<T>()(x);
+    return static_cast<std::size_t>((h * 0x9E3779B97F4A7C15ull) >> shift_);
+  }
+
+  template <typename It>
+  void insert(It values, int i) noexcept {
+    const auto t = t_.first();
+    const std::size_t mask = size_ - 1;
+    std::size_t k = slot(values[i]);
+    for (; t[k] >= 0; k = (k + 1) & mask)
+      if (values[t[k]] == values[i]) return; // keep first of duplicate values
+    t[k] = i;
+  }
+
+  compressed_pair<pointer, allocator_type> t_;
+  std::size_t size_ = 0;
+  unsigned shift_ = 62;
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
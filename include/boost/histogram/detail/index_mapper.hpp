@@ -7,10 +7,13 @@
 #ifndef BOOST_HISTOGRAM_DETAIL_INDEX_MAPPER_HPP
 #define BOOST_HISTOGRAM_DETAIL_INDEX_MAPPER_HPP
 
+#include <algorithm>
 #include <boost/container/static_vector.hpp>
 #include <boost/histogram/histogram_fwd.hpp>
 #include <cstddef>
 #include <functional>
+#include <type_traits>
+#include <vector>
 
 namespace boost {
 namespace histogram {
@@ -27,23 +30,135 @@ public:
 
   index_mapper(unsigned dim) : static_vector(dim) {}
 
+  /*
+    Adds each source counter to its destination counter. The source is read in storage
+    order, while the multi-index of the axes is incremented like an odometer, so that
+    the destination index is updated with additions instead of a division per axis. If
+    the kept axes are a prefix or a suffix of the source axes in the same order, the
+    source is a sequence of blocks which are summed directly.
+  */
   template <typename T, typename U>
-  void operator()(T& dst, const U& src) {
-    for (std::size_t i = 0; i < total; ++i) {
-      std::size_t j = 0;
-      auto imod = i;
-      for (auto it = end(); it != begin(); --it) {
-        const auto& d = *(it - 1);
-        // compiler usually optimizes div & mod into one div
-        const auto k = imod / d.stride[0];
-        imod %= d.stride[0];
-        j += k * d.stride[1];
+  void operator()(T& dst, const U& src) const {
+    operator()(dst, src, 0, total);
+  }
+
+  /// Like above, but only for the source counters with index in [begin, end).
+  template <typename T, typename U>
+  void operator()(T& dst, const U& src, std::size_t begin, std::size_t end) const {
+    const unsigned n = static_cast<unsigned>(size());
+    const auto& d = *this;
+    // kept axes form a prefix, if all others are removed
+    unsigned p = 0;
+    while (p < n && d[p].stride[1] == d[p].stride[0]) ++p;
+    if (removed(p, n)) return sum_blocks(dst, src, begin, end, p, false);
+    // kept axes form a suffix, if their strides are those of the source over a block
+    unsigned q = 0;
+    while (q < n && d[q].stride[1] == 0) ++q;
+    bool suffix = true;
+    for (unsigned r = q; r < n; ++r)
+      suffix &= d[r].stride[1] * d[q].stride[0] == d[r].stride[0];
+    if (suffix) return sum_blocks(dst, src, begin, end, q, true);
+
+    // only the start of the range needs a division per axis
+    std::size_t extent[axis::limit], k[axis::limit];
+    std::size_t j = 0;
+    for (unsigned r = 0; r < n; ++r) {
+      extent[r] = (r + 1 < n ? d[r + 1].stride[0] : total) / d[r].stride[0];
+      k[r] = begin / d[r].stride[0] % extent[r];
+      j += k[r] * d[r].stride[1];
+    }
+    for (std::size_t i = begin; i < end;) {
+      const auto m = (std::min)(extent[0] - k[0], end - i);
+      for (std::size_t t = 0; t < m; ++t) dst.add(j + t * d[0].stride[1], src[i + t]);
+      i += m;
+      j -= k[0] * d[0].stride[1];
+      k[0] = 0;
+      // increment multi-index of the other axes like an odometer
+      for (unsigned r = 1; r < n; ++r) {
+        j += d[r].stride[1];
+        if (++k[r] < extent[r]) break;
+        j -= k[r] * d[r].stride[1];
+        k[r] = 0;
+      }
+    }
+  }
+
+private:
+  bool removed(unsigned begin, unsigned end) const noexcept {
+    bool r = true;
+    for (auto i = begin; i < end; ++i) r &= (*this)[i].stride[1] == 0;
+    return r;
+  }
+
+  // axes below k are removed if suffix is true, or kept otherwise, the others vice versa
+  template <typename T, typename U>
+  void sum_blocks(T& dst, const U& src, std::size_t begin, std::size_t end, unsigned k,
+                  bool suffix) const {
+    const auto block = k < size() ? (*this)[k].stride[0] : total;
+    for (std::size_t i = begin; i < end;) {
+      const auto t0 = i % block, j = i / block;
+      const auto m = (std::min)(block - t0, end - i);
+      if (suffix) {
+        for (std::size_t t = 0; t < m; ++t) dst.add(j, src[i + t]);
+      } else {
+        for (std::size_t t = 0; t < m; ++t) dst.add(t0 + t, src[i + t]);
       }
-      dst.add(j, src[i]);
+      i += m;
     }
   }
 };
 
+/*
+  Like index_mapper::operator(), but for several destinations with the same source, so
+  that the source is read only once. The mappers must have the same source strides. A
+  row of the first axis is processed in chunks which fit into the L1 cache, each chunk
+  is added to all destinations before the next is read.
+*/
+template <typename T, typename U>
+void map_many(const std::vector<index_mapper>& ims, const std::vector<T*>& dst,
+              const U& src) {
+  const std::size_t chunk = 512;
+  if (ims.empty()) return;
+  const auto& d = ims.front();
+  const unsigned n = static_cast<unsigned>(d.size());
+  const auto ndst = ims.size();
+  std::size_t extent[axis::limit], k[axis::limit] = {};
+  for (unsigned r = 0; r < n; ++r)
+    extent[r] = (r + 1 < n ? d[r + 1].stride[0] : d.total) / d[r].stride[0];
+  std::vector<std::size_t> j(ndst, 0);
+  // source values of a chunk are read once, which may be costly for some storages
+  std::vector<std::decay_t<decltype(src[0])>> buf(chunk);
+  for (std::size_t i = 0; i < d.total; i += extent[0]) {
+    for (std::size_t c = 0; c < extent[0]; c += chunk) {
+      const auto m = (std::min)(chunk, extent[0] - c);
+      for (std::size_t t = 0; t < m; ++t) buf[t] = src[i + c + t];
+      for (std::size_t l = 0; l < ndst; ++l) {
+        auto& out = *dst[l];
+        const auto s = ims[l][0].stride[1];
+        const auto j0 = j[l] + c * s;
+        if (s == 0) {
+          // first axis is removed, the chunk is summed before it is added
+          auto sum = buf[0];
+          for (std::size_t t = 1; t < m; ++t) sum += buf[t];
+          out.add(j0, sum);
+        } else {
+          for (std::size_t t = 0; t < m; ++t) out.add(j0 + t * s, buf[t]);
+        }
+      }
+    }
+    // increment multi-index of the other axes like an odometer
+    for (unsigned r = 1; r < n; ++r) {
+      const bool carry = ++k[r] == extent[r];
+      for (std::size_t l = 0; l < ndst; ++l) {
+        const auto s = ims[l][r].stride[1];
+        j[l] = carry ? j[l] - (k[r] - 1) * s : j[l] + s;
+      }
+      if (!carry) break;
+      k[r] = 0;
+    }
+  }
+}
+
 struct index_mapper_reduce_item {
   std::size_t stride[2];
   int underflow[2], overflow[2], begin, end, merge;
@@ -56,9 +171,16 @@ public:
 
   index_mapper_reduce(unsigned dim) : static_vector(dim) {}
 
+  /// Adds each source counter to its destination counter, unless its bin is dropped.
+  template <typename T, typename U>
+  void operator()(T& dst, const U& src) const {
+    operator()(dst, src, 0, total);
+  }
+
+  /// Like above, but only for the source counters with index in [first, last).
   template <typename T, typename U>
-  void operator()(T& dst, const U& src) {
-    for (std::size_t i = 0; i < total; ++i) {
+  void operator()(T& dst, const U& src, std::size_t first, std::size_t last) const {
+    for (std::size_t i = first; i < last; ++i) {
       std::size_t j = 0;
       auto imod = i;
       bool drop = false;
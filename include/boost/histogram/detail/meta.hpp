@@ -152,6 +152,39 @@ struct has_method_options_impl {
 template <typename T>
 using has_method_options = typename has_method_options_impl<T>::type;
 
+// true if axis T has a batch method index_n which accepts pointer to X
+template <typename T, typename X>
+struct has_method_index_n_impl {
+  template <typename U, typename = decltype(std::declval<const U&>().index_n(
+                            std::declval<const X*>(), std::declval<int*>(), 0))>
+  static std::true_type Test(void*);
+  template <typename U>
+  static std::false_type Test(...);
+  using type = decltype(Test<T>(nullptr));
+};
+template <typename T, typename X>
+using has_method_index_n = typename has_method_index_n_impl<T, X>::type;
+
+BOOST_HISTOGRAM_MAKE_SFINAE(has_method_forward_approx, (&T::forward_approx));
+
+BOOST_HISTOGRAM_MAKE_SFINAE(has_method_increment_n,
+                            (std::declval<T&>().increment_n(
+                                std::declval<const std::size_t*>(), std::size_t())));
+
+BOOST_HISTOGRAM_MAKE_SFINAE(has_method_insert_zeros,
+                            (std::declval<T&>().insert_zeros(std::size_t(),
+                                                             std::size_t())));
+
+BOOST_HISTOGRAM_MAKE_SFINAE(has_method_remap,
+                            (std::declval<T&>().remap(
+                                std::size_t(), std::declval<std::size_t (&)(std::size_t)>())));
+
+// true if T can be constructed from the allocator it returns
+BOOST_HISTOGRAM_MAKE_SFINAE(has_allocator_ctor, T(std::declval<const T&>().get_allocator()));
+
+// true if axis T can grow, the update method computes the index and grows the axis
+BOOST_HISTOGRAM_MAKE_SFINAE(has_method_update, &T::update);
+
 BOOST_HISTOGRAM_MAKE_SFINAE(has_allocator, &T::get_allocator);
 
 BOOST_HISTOGRAM_MAKE_SFINAE(is_indexable, (std::declval<T&>()[0]));
@@ -179,6 +212,8 @@ BOOST_HISTOGRAM_MAKE_SFINAE(is_indexable_container, (std::declval<T&>()[0], &T::
 BOOST_HISTOGRAM_MAKE_SFINAE(is_equal_comparable,
                             (std::declval<T&>() == std::declval<T&>()));
 
+BOOST_HISTOGRAM_MAKE_SFINAE(is_hashable, (std::hash<T>()(std::declval<const T&>())));
+
 // is_axis is false for axis::variant, because operator() is templated
 BOOST_HISTOGRAM_MAKE_SFINAE(is_axis, (&T::size, &T::operator()));
 
@@ -0,0 +1,100 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_PARALLEL_HPP
+#define BOOST_HISTOGRAM_DETAIL_PARALLEL_HPP
+
+#include <algorithm>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// minimum number of source bins mapped by one thread in map_parallel
+BOOST_ATTRIBUTE_UNUSED static constexpr std::size_t map_parallel_min_bins = 1 << 16;
+
+// zero means one thread per core
+inline unsigned resolve_threads(unsigned nthreads) noexcept {
+  return nthreads ? nthreads : std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+// runs f(k) for each k in ks in a separate thread and rethrows the first exception
+template <typename F>
+void run_parallel(const std::vector<unsigned>& ks, F f) {
+  const auto n = ks.empty() ? 0u : *std::max_element(ks.begin(), ks.end()) + 1;
+  std::vector<std::exception_ptr> errors(n);
+  std::vector<std::thread> threads;
+  threads.reserve(ks.size());
+  for (auto k : ks)
+    threads.emplace_back([&errors, &f, k] {
+      try {
+        f(k);
+      } catch (...) { errors[k] = std::current_exception(); }
+    });
+  for (auto&& t : threads) t.join();
+  for (auto&& e : errors)
+    if (e) std::rethrow_exception(e);
+}
+
+// adds all storages to the first pairwise in a tree, in log2(parts.size()) rounds
+template <typename S>
+void merge_parallel(const std::vector<S*>& parts) {
+  std::vector<unsigned> ks;
+  const auto n = static_cast<unsigned>(parts.size());
+  for (unsigned step = 1; step < n; step *= 2) {
+    ks.clear();
+    for (unsigned k = 0; k + step < n; k += 2 * step) ks.push_back(k);
+    run_parallel(ks, [&](unsigned k) { *parts[k] += *parts[k + step]; });
+  }
+}
+
+/*
+  Applies an index mapper of algorithm::project or algorithm::reduce in several threads.
+
+  The source bins are split into contiguous ranges, one per thread. The first thread
+  writes into the destination, all others into an empty copy of it, which are then
+  merged. Threads never write to the same storage, which is required for storages that
+  change their memory layout when a counter is incremented.
+*/
+template <typename M, typename T, typename U>
+void map_parallel(const M& im, T& dst, const U& src, unsigned nthreads) {
+  nthreads = resolve_threads(nthreads);
+  const auto nmax = std::max(im.total / map_parallel_min_bins, std::size_t(1));
+  if (nmax < nthreads) nthreads = static_cast<unsigned>(nmax);
+
+  if (nthreads == 1) {
+    im(dst, src);
+    return;
+  }
+
+  T empty(dst);
+  empty.reset(dst.size());
+  std::vector<T> clones(nthreads - 1);
+  std::vector<T*> parts(nthreads, &dst);
+  for (unsigned k = 1; k < nthreads; ++k) parts[k] = &clones[k - 1];
+
+  std::vector<unsigned> ks(nthreads);
+  for (unsigned k = 0; k < nthreads; ++k) ks[k] = k;
+  run_parallel(ks, [&](unsigned k) {
+    // copy is made in the thread, so that its memory is close to the thread
+    if (k > 0) *parts[k] = empty;
+    const auto begin = im.total * k / nthreads;
+    const auto end = im.total * (k + 1) / nthreads;
+    im(*parts[k], src, begin, end);
+  });
+  merge_parallel(parts);
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,73 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_SIMD_DISPATCH_HPP
+#define BOOST_HISTOGRAM_DETAIL_SIMD_DISPATCH_HPP
+
+#include <boost/config.hpp>
+
+/*
+  Batch kernels are plain loops, written so that compilers can vectorize them. The
+  library is header-only and usually compiled for the baseline instruction set of the
+  target (SSE2 on x86-64), which leaves wide vector units unused. On x86 with gcc and
+  clang, the kernels are therefore compiled several times with different target
+  attributes and the widest variant supported by the CPU is selected at runtime.
+
+  Define BOOST_HISTOGRAM_NO_SIMD_DISPATCH to always use the baseline variant.
+*/
+#if !defined(BOOST_HISTOGRAM_NO_SIMD_DISPATCH) &&       \
+    (defined(BOOST_GCC) || defined(BOOST_CLANG)) &&     \
+    (defined(__x86_64__) || defined(__i386__))
+#define BOOST_HISTOGRAM_DETAIL_SIMD_DISPATCH
+#endif
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+#ifdef BOOST_HISTOGRAM_DETAIL_SIMD_DISPATCH
+
+template <typename Kernel, typename... Ts>
+__attribute__((target("avx512f"))) void simd_dispatch_avx512(const Kernel& k,
+                                                             Ts... ts) {
+  k(ts...);
+}
+
+template <typename Kernel, typename... Ts>
+__attribute__((target("avx2"))) void simd_dispatch_avx2(const Kernel& k, Ts... ts) {
+  k(ts...);
+}
+
+struct simd_level {
+  bool avx512, avx2;
+  simd_level()
+      : avx512(__builtin_cpu_supports("avx512f")), avx2(__builtin_cpu_supports("avx2")) {}
+};
+
+/// Calls kernel with arguments, using the widest instruction set supported by the CPU
+template <typename Kernel, typename... Ts>
+void simd_dispatch(const Kernel& k, Ts... ts) {
+  static const simd_level level;
+  if (level.avx512) return simd_dispatch_avx512(k, ts...);
+  if (level.avx2) return simd_dispatch_avx2(k, ts...);
+  k(ts...);
+}
+
+#else
+
+/// Calls kernel with arguments
+template <typename Kernel, typename... Ts>
+void simd_dispatch(const Kernel& k, Ts... ts) {
+  k(ts...);
+}
+
+#endif
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
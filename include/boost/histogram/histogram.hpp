@@ -11,6 +11,7 @@
 #include <boost/assert.hpp>
 #include <boost/histogram/arithmetic_operators.hpp>
 #include <boost/histogram/detail/axes.hpp>
+#include <boost/histogram/detail/fill_n.hpp>
 #include <boost/histogram/detail/meta.hpp>
 #include <boost/histogram/histogram_fwd.hpp>
 #include <boost/histogram/iterator.hpp>
@@ -34,7 +35,7 @@ public:
   using const_reference = typename storage_type::const_reference;
   using const_iterator = iterator<histogram>;
 
-  histogram() = default;
+  histogram() : layout_(axes_) {}
   histogram(const histogram& rhs) = default;
   histogram(histogram&& rhs) = default;
   histogram& operator=(const histogram& rhs) = default;
@@ -43,22 +44,24 @@ public:
   template <typename A, typename S>
   explicit histogram(const histogram<A, S>& rhs) : storage_(rhs.storage_) {
     detail::axes_assign(axes_, rhs.axes_);
+    layout_.reset(axes_);
   }
 
   template <typename A, typename S>
   histogram& operator=(const histogram<A, S>& rhs) {
     storage_ = rhs.storage_;
     detail::axes_assign(axes_, rhs.axes_);
+    layout_.reset(axes_);
     return *this;
   }
 
   explicit histogram(const axes_type& a, storage_type s = {})
-      : axes_(a), storage_(std::move(s)) {
+      : axes_(a), storage_(std::move(s)), layout_(axes_) {
     storage_.reset(detail::bincount(axes_));
   }
 
   explicit histogram(axes_type&& a, storage_type s = {})
-      : axes_(std::move(a)), storage_(std::move(s)) {
+      : axes_(std::move(a)), storage_(std::move(s)), layout_(axes_) {
     storage_.reset(detail::bincount(axes_));
   }
 
@@ -106,7 +109,7 @@ public:
     return detail::axis_get<N>(axes_);
   }
 
-  /// Get N-th axis
+  /// Get N-th axis, changing the number of bins through the reference is not allowed
   template <std::size_t N>
   decltype(auto) axis(mp11::mp_size_t<N>) {
     detail::rank_check(axes_, N);
@@ -125,7 +128,7 @@ public:
     return detail::axis_get(axes_, i);
   }
 
-  /// Get N-th axis with runtime index
+  /// Get N-th axis with runtime index, the number of bins must not be changed
   decltype(auto) axis(std::size_t i) {
     detail::rank_check(axes_, i);
     return detail::axis_get(axes_, i);
@@ -147,7 +150,81 @@ public:
   /// Fill histogram with value tuple and optional weight
   template <typename... Ts>
   void operator()(const std::tuple<Ts...>& t) {
-    detail::fill_impl(storage_, axes_, t);
+    detail::fill_impl(storage_, axes_, layout_, t);
+  }
+
+  /** Fill histogram with spans of values, one span per axis, and an optional weight span.
+
+     Each span is a contiguous container, for example a std::vector, with one element
+     per sample. All spans must have the same length. If weights are passed, they
+     must be the first argument, wrapped by `weight(...)`. This is faster than calling
+     operator() in a loop, because the indices are computed in blocks.
+   */
+  template <typename... Ts>
+  void fill(const Ts&... ts) {
+    detail::fill_n_impl(storage_, axes_, layout_, std::forward_as_tuple(ts...));
+  }
+
+  /** Fill histogram with bin indices, one index or one span of indices per axis.
+
+     This skips the computation of the indices from values. Indices are in the same
+     range as those accepted by at(), indices outside of this range are ignored. If
+     spans are passed, weights can be passed like in fill().
+   */
+  template <typename... Ts>
+  void fill_by_index(const Ts&... ts) {
+    detail::static_if<detail::is_iterable<detail::mp_last<mp11::mp_list<Ts...>>>>(
+        [this](const auto& args) {
+          detail::fill_n_by_index_impl(storage_, axes_, args);
+        },
+        [this](const auto& args) {
+          const auto idx = detail::at_impl(axes_, layout_, args);
+          if (idx) storage_(*idx);
+        },
+        std::forward_as_tuple(ts...));
+  }
+
+  /// Fill histogram with linear bin index as returned by index(), if it is valid
+  void fill_by_linear_index(std::size_t i) {
+    if (i < size()) storage_(i);
+  }
+
+  /** Fill histogram with span of linear bin indices as computed by index_n().
+
+     Invalid indices are ignored. Weights can be passed like in fill().
+   */
+  template <typename T, typename... Ts,
+            typename = mp11::mp_if<
+                mp11::mp_or<detail::is_iterable<T>, detail::is_weight<T>>, void>>
+  void fill_by_linear_index(const T& t, const Ts&... ts) {
+    detail::fill_n_by_linear_index_impl(storage_, std::forward_as_tuple(t, ts...));
+  }
+
+  /** Linear bin index for value tuple, without changing the histogram.
+
+     Returns a value not smaller than size(), if the values do not fall into any bin.
+   */
+  template <typename... Ts>
+  std::size_t index(const Ts&... ts) const {
+    return index(std::forward_as_tuple(ts...));
+  }
+
+  /// Linear bin index for value tuple (specialization for 1D)
+  template <typename... Ts>
+  std::size_t index(const std::tuple<Ts...>& t) const {
+    const auto idx = detail::args_to_index<0, sizeof...(Ts)>(axes_, layout_, t);
+    return idx ? *idx : detail::invalid_index;
+  }
+
+  /** Linear bin indices for spans of values, one span per axis.
+
+     Writes one index per sample to out, which must have space for as many indices as
+     there are samples. Indices are not smaller than size() for samples which do not
+     fall into any bin. Linear indices are valid for all histograms with equal axes.
+   */
+  template <typename... Ts>
+  void index_n(std::size_t* out, const Ts&... ts) const {
+    detail::index_n_impl(out, axes_, std::forward_as_tuple(ts...));
   }
 
   /// Access bin counter at indices
@@ -160,7 +237,7 @@ public:
   /// Access bin counter at index (specialization for 1D)
   template <typename... Ts>
   const_reference at(const std::tuple<Ts...>& t) const {
-    const auto idx = detail::at_impl(axes_, t);
+    const auto idx = detail::at_impl(axes_, layout_, t);
     if (!idx) throw std::out_of_range("indices out of bounds");
     return storage_[*idx];
   }
@@ -181,6 +258,8 @@ public:
 private:
   axes_type axes_;
   storage_type storage_;
+  // derived from axes_, updated whenever they change
+  detail::axes_layout<axes_type> layout_;
 
   template <typename A, typename S>
   friend class histogram;
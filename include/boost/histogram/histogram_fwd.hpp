@@ -9,6 +9,7 @@
 
 #include <boost/config.hpp>
 #include <boost/container/container_fwd.hpp>
+#include <cstdint>
 
 namespace boost {
 namespace histogram {
@@ -30,8 +31,15 @@ enum class option_type {
   none = 0,
   overflow = 1,
   underflow_and_overflow = 2,
+  growth = 4,     /// axis grows when a value is outside of its range
+  reciprocal = 8, /// regular axis multiplies by inverse bin width instead of dividing
 };
 
+/// Combine growth or reciprocal with one of the other options, e.g. overflow | growth
+constexpr option_type operator|(option_type a, option_type b) noexcept {
+  return static_cast<option_type>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+}
+
 namespace transform {
 template <typename T = double>
 struct identity;
@@ -47,9 +55,17 @@ template <typename Transform = transform::identity<double>,
           typename MetaData = boost::container::string>
 class regular;
 
+template <unsigned N, typename Start, typename Stop,
+          option_type Options = option_type::underflow_and_overflow,
+          typename MetaData = boost::container::string>
+class static_regular;
+
 template <typename RealType = double, typename MetaData = boost::container::string>
 class circular;
 
+template <typename RealType = double, typename MetaData = boost::container::string>
+class log_linear;
+
 template <typename RealType = double,
           typename Allocator = boost::container::new_allocator<RealType>,
           typename MetaData = boost::container::string>
@@ -66,6 +82,13 @@ template <typename... Ts>
 class variant;
 } // namespace axis
 
+namespace detail {
+// number of underflow and overflow bins, the growth bit adds no bins
+constexpr unsigned flow_bins(axis::option_type o) noexcept {
+  return static_cast<unsigned>(o) & 3u;
+}
+} // namespace detail
+
 template <typename T>
 struct weight_type;
 
@@ -91,6 +114,14 @@ struct storage_adaptor;
 template <typename Allocator = boost::container::new_allocator<void>>
 struct adaptive_storage;
 
+template <typename Allocator = boost::container::new_allocator<void>,
+          std::size_t ChunkSize = (1 << 12)>
+struct chunked_adaptive_storage;
+
+template <typename T = std::uint64_t,
+          typename Allocator = boost::container::new_allocator<void>>
+class sharded_storage;
+
 using default_storage = adaptive_storage<>;
 using weight_storage =
     storage_adaptor<boost::container::vector<accumulators::weighted_sum<>>>;
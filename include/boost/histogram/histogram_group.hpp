@@ -0,0 +1,238 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_HISTOGRAM_GROUP_HPP
+#define BOOST_HISTOGRAM_HISTOGRAM_GROUP_HPP
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/histogram/axis/variant.hpp>
+#include <boost/histogram/detail/axes.hpp>
+#include <boost/histogram/detail/fill_n.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <boost/histogram/weight.hpp>
+#include <boost/mp11.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+// compares axes held by variants or references, axes of different type are not equal
+template <typename T, typename U>
+bool axis_equal(const T& t, const U& u) {
+  return axis::visit(
+      [&u](const auto& a) {
+        return axis::visit(
+            [&a](const auto& b) {
+              return static_if<std::is_same<unqual<decltype(a)>, unqual<decltype(b)>>>(
+                  [](const auto& a, const auto& b) { return a == b; },
+                  [](const auto&, const auto&) { return false; }, a, b);
+            },
+            u);
+      },
+      t);
+}
+} // namespace detail
+
+/**
+  Group of histograms which are filled together from the same samples.
+
+  Each sample consists of several values, and each histogram in the group is filled
+  with a subset of these values. When a histogram is added, one passes for each of its
+  axes the position of the value in the sample. Axes which are equal and read the same
+  value are shared between histograms: the bin index of a shared axis is computed once
+  per sample and then used for all histograms which have this axis. Filling a group of
+  histograms which share axes therefore needs fewer axis evaluations than filling the
+  histograms one by one.
+
+  All histograms in a group have the same type. To combine histograms with different
+  numbers or types of axes, use histograms with a vector of axis::variant, the variant
+  must then include all axis types. Axes are not allowed to grow.
+
+  \tparam Histogram type of the histograms in the group.
+ */
+template <typename Histogram>
+class histogram_group {
+public:
+  using histogram_type = Histogram;
+
+  histogram_group() = default;
+
+  /** Add histogram to group, returns its position in the group.
+
+     The k-th axis of the histogram is filled with the value at position columns[k] of
+     each sample. Throws std::invalid_argument if the number of columns is not equal to
+     the rank of the histogram, or if an axis has option_type::growth.
+   */
+  std::size_t add(histogram_type h, const std::vector<unsigned>& columns) {
+    if (columns.size() != h.rank())
+      throw std::invalid_argument("number of columns != histogram rank");
+    const auto& axes = unsafe_access::axes(h);
+    if (detail::has_growth(axes))
+      throw std::invalid_argument("histogram_group does not support axes that grow");
+    std::size_t stride = 1;
+    for (unsigned k = 0; k < columns.size(); ++k) {
+      decltype(auto) a = detail::axis_get(axes, k);
+      // unique_ is small, a linear search is fast enough
+      auto it = std::find_if(unique_.begin(), unique_.end(), [&](const unique_axis& u) {
+        if (u.column != columns[k]) return false;
+        // axis may belong to h itself, which is not yet in histograms_
+        const auto& u_axes = u.hist < histograms_.size()
+                                 ? unsafe_access::axes(histograms_[u.hist])
+                                 : axes;
+        return detail::axis_equal(detail::axis_get(u_axes, u.axis), a);
+      });
+      if (it == unique_.end())
+        it = unique_.insert(it, unique_axis{columns[k], histograms_.size(), k});
+      slots_.push_back(slot{static_cast<std::size_t>(it - unique_.begin()), stride});
+      stride *= static_cast<std::size_t>(axis::traits::extend(a));
+      ncolumns_ = std::max(ncolumns_, columns[k] + 1);
+    }
+    offsets_.push_back(slots_.size());
+    histograms_.emplace_back(std::move(h));
+    return histograms_.size() - 1;
+  }
+
+  /// Add histogram to group, the k-th axis is filled with the k-th value of the sample
+  std::size_t add(histogram_type h) {
+    std::vector<unsigned> columns(h.rank());
+    for (unsigned k = 0; k < columns.size(); ++k) columns[k] = k;
+    return add(std::move(h), columns);
+  }
+
+  /// Number of histograms in the group
+  std::size_t size() const noexcept { return histograms_.size(); }
+
+  /// Number of distinct axes, which are evaluated for each sample
+  std::size_t unique_axes() const noexcept { return unique_.size(); }
+
+  /// Access histogram at position i
+  const histogram_type& operator[](std::size_t i) const {
+    BOOST_ASSERT(i < size());
+    return histograms_[i];
+  }
+
+  /// Reset bin counters of all histograms to zero
+  void reset() {
+    for (auto&& h : histograms_) h.reset();
+  }
+
+  /** Fill histograms with one sample and optional weight.
+
+     The weight must be the first argument, it is used for all histograms.
+   */
+  template <typename... Ts>
+  void operator()(const Ts&... ts) {
+    using L = mp11::mp_list<Ts...>;
+    constexpr unsigned offset = detail::is_weight<mp11::mp_first<L>>::value;
+    const auto args = std::forward_as_tuple(ts...);
+    fill_block<sizeof...(Ts) - offset>(
+        [&args](auto I) { return &std::get<(offset + I)>(args); }, 1,
+        [&args](auto& storage, std::size_t* idx) {
+          if (*idx >= storage.size()) return;
+          detail::static_if_c<(offset == 1)>(
+              [&storage, idx](const auto& args) { storage(*idx, std::get<0>(args)); },
+              [&storage, idx](const auto&) { storage(*idx); }, args);
+        });
+  }
+
+  /** Fill histograms with spans of values, one span per value in the sample.
+
+     Accepts the same arguments as histogram::fill, a span of weights is optional and
+     must be the first argument. Throws std::invalid_argument if the spans have
+     different lengths.
+   */
+  template <typename... Ts>
+  void fill(const Ts&... ts) {
+    using L = mp11::mp_list<Ts...>;
+    constexpr unsigned offset = detail::is_weight<mp11::mp_first<L>>::value;
+    const auto args = std::forward_as_tuple(ts...);
+    const std::size_t n = detail::span_size_check(args);
+    for (std::size_t start = 0; start < n; start += detail::fill_n_block_size) {
+      const auto m = std::min(detail::fill_n_block_size, n - start);
+      fill_block<sizeof...(Ts) - offset>(
+          [&args, start](auto I) {
+            return detail::span_data(std::get<(offset + I)>(args)) + start;
+          },
+          m,
+          [&args, start, m](auto& storage, std::size_t* idx) {
+            detail::static_if_c<(offset == 1)>(
+                [&](const auto& args) {
+                  detail::fill_storage_n(storage, idx, m,
+                                         detail::span_data(std::get<0>(args)) + start);
+                },
+                [&](const auto&) { detail::fill_storage_n(storage, idx, m); }, args);
+          });
+    }
+  }
+
+private:
+  struct unique_axis {
+    unsigned column;  // position of value in sample
+    std::size_t hist; // first histogram with this axis
+    unsigned axis;    // position of axis in this histogram
+  };
+
+  struct slot {
+    std::size_t unique; // position in unique_
+    std::size_t stride;
+  };
+
+  // values(I) returns pointer to the first of n values at position I of the sample,
+  // store(storage, idx) fills the storage with the n linear indices in idx
+  template <unsigned N, typename Values, typename Store>
+  void fill_block(Values values, const std::size_t n, Store store) {
+    static_assert(N > 0, "at least one value required");
+    BOOST_ASSERT(n <= detail::fill_n_block_size);
+    if (ncolumns_ > N)
+      throw std::invalid_argument("number of values < columns used by histograms");
+    constexpr auto block = detail::fill_n_block_size;
+    buffer_.resize(unique_.size() * block);
+
+    // bin index of each unique axis, computed once for all histograms
+    for (std::size_t u = 0; u < unique_.size(); ++u) {
+      const auto& ua = unique_[u];
+      const auto& axes = unsafe_access::axes(histograms_[ua.hist]);
+      decltype(auto) a = detail::axis_get(axes, ua.axis);
+      const auto out = &buffer_[u * block];
+      std::fill(out, out + n, 0);
+      mp11::mp_with_index<N>(
+          ua.column, [&](auto I) { detail::linearize_n(out, 1, n, a, values(I)); });
+    }
+
+    std::size_t idx[block];
+    for (std::size_t h = 0; h < histograms_.size(); ++h) {
+      std::fill(idx, idx + n, 0);
+      for (auto s = offsets_[h]; s < offsets_[h + 1]; ++s) {
+        const auto j = &buffer_[slots_[s].unique * block];
+        const auto stride = slots_[s].stride;
+        // invalid_index is larger than any valid linear index plus j * stride
+        for (std::size_t i = 0; i < n; ++i)
+          idx[i] = j[i] < detail::invalid_index ? idx[i] + j[i] * stride
+                                                : detail::invalid_index;
+      }
+      store(unsafe_access::storage(histograms_[h]), idx);
+    }
+  }
+
+  std::vector<histogram_type> histograms_;
+  std::vector<unique_axis> unique_;
+  std::vector<slot> slots_;                  // axes of all histograms in order
+  std::vector<std::size_t> offsets_ = {0};   // slots of histogram i start at offsets_[i]
+  std::vector<std::size_t> buffer_;          // bin indices of unique axes for one block
+  unsigned ncolumns_ = 0;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
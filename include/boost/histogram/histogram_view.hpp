@@ -0,0 +1,307 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_HISTOGRAM_VIEW_HPP
+#define BOOST_HISTOGRAM_HISTOGRAM_VIEW_HPP
+
+#include <boost/container/static_vector.hpp>
+#include <boost/histogram/algorithm/reduce.hpp>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/detail/index_mapper.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/mp11.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+
+namespace boost {
+namespace histogram {
+namespace algorithm {
+
+struct slice_option_type {
+  unsigned iaxis;
+  int index;
+};
+
+/// Select bin with index on axis iaxis, the axis is removed from the view.
+inline slice_option_type slice(unsigned iaxis, int index) { return {iaxis, index}; }
+
+} // namespace algorithm
+
+/**
+  Read-only view of a part of a histogram, which does not copy or allocate anything.
+
+  The view is created from a histogram and options, which are either shrink options of
+  algorithm::reduce or slice options. An axis with a shrink option keeps the bins within
+  the range of the option, an axis with a slice option is removed and only the bins
+  with the given index on this axis are seen. The view has the same interface for
+  reading bins as the histogram, the indices on the remaining axes start at zero like
+  in a histogram returned by algorithm::reduce, but the view has no flow bins.
+
+  The view references the histogram, which must outlive the view and must not be
+  filled while the view is used. Call materialize to get a histogram.
+
+  \tparam Histogram type of the viewed histogram.
+*/
+template <typename Histogram>
+class histogram_view {
+public:
+  using histogram_type = Histogram;
+  using value_type = typename histogram_type::value_type;
+  using const_reference = typename histogram_type::const_reference;
+  class const_iterator;
+
+  /** Create view of histogram.
+
+    Throws std::invalid_argument if an option is not a shrink or slice option, if an
+    axis has more than one option, and std::out_of_range if the bin of a slice option
+    does not exist.
+  */
+  template <typename... Ts>
+  explicit histogram_view(const histogram_type& h, const Ts&... ts) : histogram_(&h) {
+    axes_.resize(h.rank());
+    using swallow = int[];
+    (void)swallow{0, (set_option(ts), 0)...};
+
+    std::size_t stride = 1;
+    unsigned iaxis = 0;
+    h.for_each_axis([&](const auto& a) {
+      auto& d = axes_[iaxis++];
+      d.size = a.size();
+      const int flow = static_cast<int>(detail::flow_bins(axis::traits::options(a)));
+      if (d.sliced) {
+        // slice index is checked here, because the axis is only known here
+        if (d.begin < -(flow == 2) || d.begin >= d.size + (flow > 0))
+          throw std::out_of_range("slice index out of range");
+        offset_ += (d.begin < 0 ? d.size + 1 : d.begin) * stride;
+      } else {
+        unsigned begin = 0, end = a.size();
+        if (d.shrunk) detail::shrink_bins(a, d.lower, d.upper, begin, end);
+        d.begin = begin;
+        d.end = end;
+        offset_ += begin * stride;
+        kept_.push_back(kept_axis{iaxis - 1, d.end - d.begin, stride});
+        size_ *= d.end - d.begin;
+      }
+      stride *= axis::traits::extend(a);
+    });
+  }
+
+  /// Number of axes which are not sliced
+  std::size_t rank() const noexcept { return kept_.size(); }
+
+  /// Total number of bins in the view
+  std::size_t size() const noexcept { return size_; }
+
+  /// Number of bins of axis i of the view
+  int size(unsigned i) const noexcept { return kept_[i].size; }
+
+  /// Access bin counter at indices
+  template <typename... Ts>
+  const_reference at(const Ts&... ts) const {
+    return at(std::forward_as_tuple(ts...));
+  }
+
+  /// Access bin counter at indices in a tuple
+  template <typename... Ts>
+  const_reference at(const std::tuple<Ts...>& t) const {
+    if (sizeof...(Ts) != rank())
+      throw std::invalid_argument("number of arguments != histogram rank");
+    std::size_t j = offset_;
+    mp11::mp_for_each<mp11::mp_iota_c<sizeof...(Ts)>>([&](auto I) {
+      const auto& d = kept_[I];
+      const int i = static_cast<int>(std::get<I>(t));
+      if (i < 0 || i >= d.size) throw std::out_of_range("indices out of bounds");
+      j += i * d.stride;
+    });
+    return unsafe_access::storage(*histogram_)[j];
+  }
+
+  /// Access bin counter at index
+  template <typename T>
+  const_reference operator[](const T& t) const {
+    return at(t);
+  }
+
+  const_iterator begin() const noexcept { return const_iterator(*this, 0); }
+
+  const_iterator end() const noexcept { return const_iterator(*this, size()); }
+
+  /** Returns a histogram with the bins of the view.
+
+    Equal to the histogram returned by algorithm::reduce with the shrink options, from
+    which the sliced axes are removed by selecting the bins of the slices. Like in that
+    histogram, bins outside of the shrunk range are added to the flow bins. Only
+    available for histograms with a vector of axes.
+  */
+  template <typename H = histogram_type,
+            typename = detail::requires_axis_vector<typename H::axes_type>>
+  histogram_type materialize() const {
+    using A = typename H::axes_type;
+    using S = typename H::storage_type;
+    const auto& h = *histogram_;
+    auto r_axes = detail::static_if<detail::has_allocator<A>>(
+        [](const auto& axes) {
+          using T = detail::unqual<decltype(axes)>;
+          return T(axes.get_allocator());
+        },
+        [](const auto& axes) {
+          using T = detail::unqual<decltype(axes)>;
+          return T();
+        },
+        unsafe_access::axes(h));
+    r_axes.reserve(rank());
+
+    detail::index_mapper_reduce im(h.rank());
+    std::size_t stride[2] = {1, 1};
+    unsigned iaxis = 0;
+    h.for_each_axis([&](const auto& a) {
+      using T = detail::unqual<decltype(a)>;
+      const auto& d = axes_[iaxis];
+      auto& m = im[iaxis++];
+      const auto n = axis::traits::extend(a);
+      im.total *= n;
+      m.stride[0] = stride[0];
+      stride[0] *= n;
+      m.merge = 1;
+      if (d.sliced) {
+        // everything except the selected bin is dropped
+        m.begin = d.begin < 0 ? d.size + 1 : d.begin;
+        m.end = m.begin + 1;
+        m.underflow[0] = m.overflow[0] = m.underflow[1] = m.overflow[1] = -1;
+        m.stride[1] = 0;
+        return;
+      }
+      detail::set_flow_bins(m, 0, a);
+      m.begin = d.begin;
+      m.end = d.end;
+      m.stride[1] = stride[1];
+      if (d.shrunk) {
+        auto a2 = T(a, d.begin, d.end, 1);
+        detail::set_flow_bins(m, 1, a2);
+        stride[1] *= axis::traits::extend(a2);
+        r_axes.emplace_back(std::move(a2));
+      } else {
+        detail::set_flow_bins(m, 1, a);
+        stride[1] *= n;
+        r_axes.emplace_back(a);
+      }
+    });
+
+    auto r = histogram_type(
+        std::move(r_axes),
+        detail::static_if<detail::has_allocator<S>>(
+            [&h](auto) { return S(unsafe_access::storage(h).get_allocator()); },
+            [](auto) { return S(); }, 0));
+    im(unsafe_access::storage(r), unsafe_access::storage(h));
+    return r;
+  }
+
+private:
+  struct axis_data {
+    bool shrunk = false, sliced = false;
+    double lower = 0, upper = 0;
+    int size = 0, begin = 0, end = 0; // begin is the bin index for sliced axes
+  };
+
+  struct kept_axis {
+    unsigned iaxis;
+    int size;
+    std::size_t stride;
+  };
+
+  axis_data& option_target(unsigned iaxis) {
+    if (iaxis >= axes_.size()) throw std::invalid_argument("invalid axis index");
+    auto& d = axes_[iaxis];
+    if (d.shrunk || d.sliced) throw std::invalid_argument("indices must be unique");
+    return d;
+  }
+
+  void set_option(const algorithm::reduce_option_type& o) {
+    if (o.merge != 1) throw std::invalid_argument("view cannot rebin");
+    auto& d = option_target(o.iaxis);
+    d.shrunk = true;
+    d.lower = o.lower;
+    d.upper = o.upper;
+  }
+
+  void set_option(const algorithm::slice_option_type& o) {
+    auto& d = option_target(o.iaxis);
+    d.sliced = true;
+    d.begin = o.index;
+  }
+
+  const histogram_type* histogram_;
+  boost::container::static_vector<axis_data, axis::limit> axes_;
+  boost::container::static_vector<kept_axis, axis::limit> kept_;
+  std::size_t offset_ = 0, size_ = 1;
+
+public:
+  /// Iterator over bins of the view with access to the multi-dimensional index.
+  class const_iterator
+      : public iterator_facade<const_iterator, value_type, random_access_traversal_tag,
+                               const_reference> {
+  public:
+    const_iterator(const histogram_view& v, std::size_t idx) : view_(&v), idx_(idx) {}
+
+    std::size_t rank() const noexcept { return view_->rank(); }
+
+    /// Index of the current bin on axis dim of the view
+    int idx(unsigned dim = 0) const noexcept {
+      auto k = idx_;
+      for (unsigned r = 0; r < dim; ++r) k /= view_->kept_[r].size;
+      return static_cast<int>(k % view_->kept_[dim].size);
+    }
+
+    /// Current bin on axis dim of the view, from the axis of the viewed histogram
+    decltype(auto) bin(unsigned dim = 0) const {
+      const auto& d = view_->kept_[dim];
+      return view_->histogram_->axis(d.iaxis)[view_->axes_[d.iaxis].begin + idx(dim)];
+    }
+
+  private:
+    bool equal(const const_iterator& rhs) const noexcept {
+      return view_ == rhs.view_ && idx_ == rhs.idx_;
+    }
+
+    void increment() noexcept { ++idx_; }
+    void decrement() noexcept { --idx_; }
+    void advance(std::ptrdiff_t n) noexcept { idx_ += n; }
+
+    std::ptrdiff_t distance_to(const const_iterator& rhs) const noexcept {
+      return static_cast<std::ptrdiff_t>(rhs.idx_) - static_cast<std::ptrdiff_t>(idx_);
+    }
+
+    const_reference dereference() const {
+      auto k = idx_;
+      auto j = view_->offset_;
+      for (const auto& d : view_->kept_) {
+        j += (k % d.size) * d.stride;
+        k /= d.size;
+      }
+      return unsafe_access::storage(*view_->histogram_)[j];
+    }
+
+    const histogram_view* view_;
+    std::size_t idx_;
+    friend class ::boost::iterator_core_access;
+  };
+};
+
+/// Create view of histogram with shrink and slice options, see histogram_view.
+template <typename A, typename S, typename... Ts>
+histogram_view<histogram<A, S>> make_histogram_view(const histogram<A, S>& h,
+                                                    const Ts&... ts) {
+  return histogram_view<histogram<A, S>>(h, ts...);
+}
+
+} // namespace histogram
+} // namespace boost
+
+#endif
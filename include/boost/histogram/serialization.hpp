@@ -18,9 +18,12 @@
 #include <boost/histogram/axis/category.hpp>
 #include <boost/histogram/axis/circular.hpp>
 #include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
 #include <boost/histogram/axis/variable.hpp>
 #include <boost/histogram/axis/variant.hpp>
+#include <boost/histogram/chunked_adaptive_storage.hpp>
 #include <boost/histogram/detail/buffer.hpp>
 #include <boost/histogram/histogram.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
@@ -142,11 +145,20 @@ void serialize(Archive& ar, adaptive_storage<A>& s, unsigned /* version */) {
   S::apply(detail::serializer(), s.buffer, ar);
 }
 
+template <class Archive, typename A, std::size_t N>
+void serialize(Archive& ar, chunked_adaptive_storage<A, N>& s, unsigned /* version */) {
+  std::size_t size = s.size();
+  ar& size;
+  if (Archive::is_loading::value) s.reset(size);
+  for (auto&& c : s.chunks) ar& c;
+}
+
 template <typename A, typename S>
 template <class Archive>
 void histogram<A, S>::serialize(Archive& ar, unsigned /* version */) {
   ar& axes_;
   ar& storage_;
+  if (Archive::is_loading::value) layout_.reset(axes_);
 }
 
 namespace axis {
@@ -174,6 +186,13 @@ void regular<T, M>::serialize(Archive& ar, unsigned /* version */) {
   ar& static_cast<transform_type&>(*this);
   ar& min_;
   ar& delta_;
+  inv_delta_ = 1 / delta_; // not stored, derived from delta_
+}
+
+template <unsigned N, typename B, typename E, option_type O, typename M>
+template <class Archive>
+void static_regular<N, B, E, O, M>::serialize(Archive& ar, unsigned /* version */) {
+  ar& meta_;
 }
 
 template <typename R, typename M>
@@ -182,6 +201,18 @@ void circular<R, M>::serialize(Archive& ar, unsigned /* version */) {
   ar& static_cast<base_type&>(*this);
   ar& phase_;
   ar& delta_;
+  // stored, because 1 / (delta_ * size()) may differ from the value computed by the
+  // constructor in the last bit, which moves edge values to another bin
+  ar& scale_;
+}
+
+template <typename R, typename M>
+template <class Archive>
+void log_linear<R, M>::serialize(Archive& ar, unsigned /* version */) {
+  ar& static_cast<base_type&>(*this);
+  ar& first_;
+  ar& shift_;
+  if (Archive::is_loading::value) set_range();
 }
 
 template <typename R, typename A, typename M>
@@ -193,6 +224,7 @@ void variable<R, A, M>::serialize(Archive& ar, unsigned /* version */) {
   if (Archive::is_loading::value)
     x_.first() = boost::histogram::detail::create_buffer(x_.second(), nx());
   ar& boost::serialization::make_array(x_.first(), nx());
+  if (Archive::is_loading::value) update_index();
 }
 
 template <typename I, typename M>
@@ -207,11 +239,14 @@ template <class Archive>
 void category<V, A, M>::serialize(Archive& ar, unsigned /* version */) {
   // destroy must happen before base serialization with old size
   if (Archive::is_loading::value)
-    detail::destroy_buffer(x_.second(), x_.first(), base_type::size());
+    detail::destroy_buffer(x_.second(), x_.first(), base_type::size(), capacity_);
   ar& static_cast<base_type&>(*this);
-  if (Archive::is_loading::value)
+  if (Archive::is_loading::value) {
     x_.first() = boost::histogram::detail::create_buffer(x_.second(), base_type::size());
+    capacity_ = base_type::size();
+  }
   ar& boost::serialization::make_array(x_.first(), base_type::size());
+  if (Archive::is_loading::value) update_index();
 }
 
 template <typename... Ts>
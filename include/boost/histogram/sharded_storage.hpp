@@ -0,0 +1,232 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_SHARDED_STORAGE_HPP
+#define BOOST_HISTOGRAM_SHARDED_STORAGE_HPP
+
+#include <atomic>
+#include <boost/assert.hpp>
+#include <boost/histogram/detail/buffer.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+// small number which is unique for each thread, assigned on first use
+inline unsigned this_thread_number() noexcept {
+  static std::atomic<unsigned> next(0);
+  thread_local const unsigned n = next.fetch_add(1, std::memory_order_relaxed);
+  return n;
+}
+} // namespace detail
+
+/** Storage for concurrent filling from many threads without locks.
+
+  The counters are split into shards, each shard holds a full set of bin counters. A
+  thread always increments the counters in the same shard, which is selected by a number
+  that is unique for each thread. The shards start on separate cache lines, so that
+  threads which write to different shards do not invalidate each other's caches (false
+  sharing). Counters are incremented with relaxed atomic operations, which is correct
+  also when more threads than shards write to the storage. Reading a bin counter sums
+  the counters of all shards.
+
+  Filling scales with the number of threads as long as there are at least as many
+  shards as threads. The memory consumption is the number of shards times the memory of
+  a plain array of counters. Weighted fills are not supported. Copying and adding
+  storages is only safe when no thread is filling.
+
+  \tparam T integral counter type.
+  \tparam Allocator allocator for the counters.
+ */
+template <typename T, typename Allocator>
+class sharded_storage {
+  static_assert(std::is_integral<T>::value, "counter type must be integral");
+
+  using counter_type = std::atomic<T>;
+  using counter_allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<counter_type>;
+  using pointer = typename std::allocator_traits<counter_allocator_type>::pointer;
+  static_assert(std::is_same<pointer, counter_type*>::value,
+                "sharded_storage requires allocator with trivial pointer type");
+
+  static constexpr std::size_t cache_line = 64;
+  static constexpr std::size_t counters_per_line =
+      sizeof(counter_type) < cache_line ? cache_line / sizeof(counter_type) : 1;
+
+public:
+  struct storage_tag {};
+  using allocator_type = Allocator;
+  using value_type = T;
+  using const_reference = T;
+
+  /// Make storage with nshards shards, if zero use one shard per hardware thread
+  explicit sharded_storage(unsigned nshards = 0,
+                           const allocator_type& a = allocator_type())
+      : alloc_(a), nshards_(nshards ? nshards : std::thread::hardware_concurrency()) {
+    if (nshards_ == 0) nshards_ = 1;
+  }
+
+  sharded_storage(const sharded_storage& o)
+      : alloc_(o.alloc_), nshards_(o.nshards_) {
+    reset(o.size_);
+    copy_counters(o);
+  }
+
+  sharded_storage& operator=(const sharded_storage& o) {
+    if (this != &o) {
+      if (nshards_ != o.nshards_ || size_ != o.size_) {
+        nshards_ = o.nshards_;
+        reset(o.size_);
+      }
+      copy_counters(o);
+    }
+    return *this;
+  }
+
+  sharded_storage(sharded_storage&& o) : alloc_(o.alloc_), nshards_(o.nshards_) {
+    swap_buffers(o);
+  }
+
+  sharded_storage& operator=(sharded_storage&& o) {
+    if (this != &o) {
+      std::swap(alloc_, o.alloc_);
+      std::swap(nshards_, o.nshards_);
+      swap_buffers(o);
+    }
+    return *this;
+  }
+
+  ~sharded_storage() { destroy(); }
+
+  allocator_type get_allocator() const { return alloc_; }
+
+  void reset(std::size_t s) {
+    destroy();
+    // stride is a multiple of the cache line, so that each shard starts on a new line
+    stride_ = (s + counters_per_line - 1) / counters_per_line * counters_per_line;
+    // one extra cache line to align the first shard
+    nraw_ = nshards_ * stride_ + counters_per_line;
+    counter_allocator_type a(alloc_);
+    raw_ = detail::create_buffer(a, nraw_, T(0));
+    const auto addr = reinterpret_cast<std::uintptr_t>(raw_);
+    const auto offset = (cache_line - addr % cache_line) % cache_line;
+    first_ = raw_ + offset / sizeof(counter_type);
+    size_ = s;
+  }
+
+  std::size_t size() const noexcept { return size_; }
+
+  unsigned shards() const noexcept { return nshards_; }
+
+  // increase by one, safe to call concurrently
+  void operator()(std::size_t i) noexcept {
+    BOOST_ASSERT(i < size());
+    shard()[i].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // increase by one for each of n indices, safe to call concurrently
+  void increment_n(const std::size_t* idx, std::size_t n) noexcept {
+    const auto p = shard();
+    for (std::size_t k = 0; k < n; ++k) {
+      BOOST_ASSERT(idx[k] < size());
+      p[idx[k]].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // increase by x, safe to call concurrently
+  template <typename U>
+  void add(std::size_t i, const U& x) noexcept {
+    BOOST_ASSERT(i < size());
+    shard()[i].fetch_add(static_cast<T>(x), std::memory_order_relaxed);
+  }
+
+  // sum over all shards
+  const_reference operator[](std::size_t i) const noexcept {
+    BOOST_ASSERT(i < size());
+    T sum = 0;
+    for (unsigned k = 0; k < nshards_; ++k)
+      sum += first_[k * stride_ + i].load(std::memory_order_relaxed);
+    return sum;
+  }
+
+  template <typename U>
+  bool operator==(const U& o) const {
+    if (size() != o.size()) return false;
+    for (std::size_t i = 0; i < size(); ++i)
+      if (!(static_cast<double>(operator[](i)) == o[i])) return false;
+    return true;
+  }
+
+  // precondition: storages have same size
+  sharded_storage& operator+=(const sharded_storage& o) {
+    BOOST_ASSERT(o.size() == size());
+    if (this == &o) {
+      // self-adding doubles every counter in every shard
+      for (std::size_t j = 0, n = nshards_ * stride_; j < n; ++j)
+        first_[j].store(2 * first_[j].load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    } else {
+      for (std::size_t i = 0; i < size_; ++i) add_to_first_shard(i, o[i]);
+    }
+    return *this;
+  }
+
+  // precondition: storages have same size
+  template <typename S>
+  sharded_storage& operator+=(const S& rhs) {
+    BOOST_ASSERT(rhs.size() == size());
+    for (std::size_t i = 0; i < size_; ++i) add_to_first_shard(i, rhs[i]);
+    return *this;
+  }
+
+private:
+  template <typename U>
+  void add_to_first_shard(std::size_t i, const U& x) noexcept {
+    first_[i].fetch_add(static_cast<T>(x), std::memory_order_relaxed);
+  }
+
+  counter_type* shard() const noexcept {
+    return first_ + (detail::this_thread_number() % nshards_) * stride_;
+  }
+
+  void copy_counters(const sharded_storage& o) noexcept {
+    for (std::size_t j = 0, n = nshards_ * stride_; j < n; ++j)
+      first_[j].store(o.first_[j].load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+  }
+
+  void swap_buffers(sharded_storage& o) noexcept {
+    std::swap(raw_, o.raw_);
+    std::swap(first_, o.first_);
+    std::swap(nraw_, o.nraw_);
+    std::swap(stride_, o.stride_);
+    std::swap(size_, o.size_);
+  }
+
+  void destroy() noexcept {
+    counter_allocator_type a(alloc_);
+    detail::destroy_buffer(a, raw_, nraw_);
+    raw_ = first_ = nullptr;
+    nraw_ = stride_ = size_ = 0;
+  }
+
+  allocator_type alloc_;
+  unsigned nshards_;
+  counter_type* raw_ = nullptr;
+  counter_type* first_ = nullptr;
+  std::size_t nraw_ = 0, stride_ = 0, size_ = 0;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,267 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_SUMMED_AREA_TABLE_HPP
+#define BOOST_HISTOGRAM_SUMMED_AREA_TABLE_HPP
+
+#include <algorithm>
+#include <boost/container/static_vector.hpp>
+#include <boost/histogram/accumulators/weighted_sum.hpp>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/parallel.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+/**
+  Table of cumulative sums of a histogram, which returns the sum over any box of bins
+  with 2^rank lookups.
+
+  Entry (c_0, c_1, ...) of the table holds the sum of all bins with index j_k < c_k on
+  each axis k, where the bins are ordered like their indices, underflow first and
+  overflow last. The sum over a box is then a signed sum of the entries at its corners.
+  The table holds a copy of the bin values and the cumulative sums, which is about
+  twice the memory of a storage with the same value type.
+
+  The table is not updated automatically when the histogram is filled. Calling update
+  compares the histogram with the copy and recomputes the cumulative sums only from the
+  first slice of the last axis which changed, which is cheap if only the last slices
+  change, for example when the last axis is time. It rebuilds the whole table if the
+  axes changed their number of bins.
+
+  \tparam T value type of the table, e.g. double or accumulators::weighted_sum<>.
+*/
+template <typename T = double>
+class summed_area_table {
+public:
+  using value_type = T;
+
+  summed_area_table() = default;
+
+  /// Build table of the histogram, see update for the meaning of nthreads.
+  template <typename A, typename S>
+  explicit summed_area_table(const histogram<A, S>& h, unsigned nthreads = 1) {
+    update(h, nthreads);
+  }
+
+  /** Update table after the histogram changed.
+
+    The cumulative sums of large tables are computed in nthreads threads. If nthreads is
+    zero, std::thread::hardware_concurrency() threads are used.
+  */
+  template <typename A, typename S>
+  void update(const histogram<A, S>& h, unsigned nthreads = 1) {
+    axes_type axes;
+    std::size_t nvalues = 1, ntable = 1;
+    h.for_each_axis([&](const auto& a) {
+      axis_data d;
+      d.extent = axis::traits::extend(a);
+      d.uflow = detail::flow_bins(axis::traits::options(a)) == 2;
+      d.size = d.extent - static_cast<int>(detail::flow_bins(axis::traits::options(a)));
+      d.stride[0] = nvalues;
+      d.stride[1] = ntable;
+      nvalues *= d.extent;
+      ntable *= d.extent + 1;
+      axes.push_back(d);
+    });
+
+    const auto n = static_cast<unsigned>(axes.size());
+    const auto& last = axes.back();
+    bool same = n == axes_.size();
+    for (unsigned r = 0; same && r < n; ++r) same = axes[r].extent == axes_[r].extent;
+    if (!same) {
+      axes_ = axes;
+      values_.assign(nvalues, value_type());
+      table_.assign(ntable, value_type());
+    }
+
+    // copy bins in index order and find the first changed slice of the last axis
+    const auto& storage = unsafe_access::storage(h);
+    int first = same ? last.extent : 0;
+    std::size_t k[axis::limit] = {};
+    std::size_t j = 0; // position of bin with storage index i in values_
+    for (unsigned r = 0; r < n; ++r) j += axes_[r].position(0) * axes_[r].stride[0];
+    for (std::size_t i = 0; i < nvalues; ++i) {
+      const auto x = static_cast<value_type>(storage[i]);
+      if (!(values_[j] == x)) {
+        values_[j] = x;
+        first = (std::min)(first, static_cast<int>(j / last.stride[0]));
+      }
+      for (unsigned r = 0; r < n; ++r) {
+        const auto& d = axes_[r];
+        j -= d.position(static_cast<int>(k[r])) * d.stride[0];
+        if (++k[r] == static_cast<std::size_t>(d.extent)) k[r] = 0;
+        j += d.position(static_cast<int>(k[r])) * d.stride[0];
+        if (k[r]) break;
+      }
+    }
+    if (first < last.extent) accumulate(first, nthreads);
+  }
+
+  /** Returns sum over the box of bins with index begin[k] <= j_k < end[k] on axis k.
+
+    The indices are those of histogram::at, -1 is the underflow bin and the number of
+    bins is the overflow bin. Throws std::invalid_argument if the number of indices is
+    not equal to the rank, and std::out_of_range if a range is not within the bins.
+  */
+  template <typename C, typename = detail::requires_iterable<C>>
+  value_type sum(const C& begin, const C& end) const {
+    const unsigned n = rank();
+    const auto nb = std::distance(std::begin(begin), std::end(begin));
+    const auto ne = std::distance(std::begin(end), std::end(end));
+    if (nb != static_cast<decltype(nb)>(n) || ne != static_cast<decltype(ne)>(n))
+      throw std::invalid_argument("number of indices != rank");
+    if (n == 0) return value_type();
+    int lower[axis::limit], upper[axis::limit];
+    auto ib = std::begin(begin);
+    auto ie = std::begin(end);
+    for (unsigned r = 0; r < n; ++r, ++ib, ++ie) {
+      const auto& d = axes_[r];
+      lower[r] = static_cast<int>(*ib) + d.uflow;
+      upper[r] = static_cast<int>(*ie) + d.uflow;
+      if (!(0 <= lower[r] && lower[r] <= upper[r] && upper[r] <= d.extent))
+        throw std::out_of_range("bin range is outside of axis");
+    }
+    // inclusion-exclusion over the corners, the sign is negative for an odd number of
+    // lower corners
+    value_type pos = value_type(), neg = value_type();
+    for (unsigned mask = 0; mask < (1u << n); ++mask) {
+      std::size_t j = 0;
+      unsigned parity = 0;
+      for (unsigned r = 0; r < n; ++r) {
+        const auto low = (mask >> r) & 1u;
+        j += (low ? lower[r] : upper[r]) * axes_[r].stride[1];
+        parity ^= low;
+      }
+      if (parity)
+        neg += table_[j];
+      else
+        pos += table_[j];
+    }
+    subtract(pos, neg);
+    return pos;
+  }
+
+  /// Returns sum over the box of bins, see above.
+  value_type sum(std::initializer_list<int> begin, std::initializer_list<int> end) const {
+    return sum<std::initializer_list<int>>(begin, end);
+  }
+
+  /// Returns the number of axes.
+  unsigned rank() const noexcept { return static_cast<unsigned>(axes_.size()); }
+
+private:
+  struct axis_data {
+    int extent, size, uflow;
+    std::size_t stride[2]; // in values_ and table_
+
+    // position of bin with storage index i in index order, the underflow bin is stored
+    // after the overflow bin
+    std::size_t position(int i) const noexcept {
+      const int j = i < size ? i + uflow : (i == size ? size + uflow : 0);
+      return static_cast<std::size_t>(j);
+    }
+  };
+  using axes_type = boost::container::static_vector<axis_data, axis::limit>;
+
+  template <typename U>
+  static void subtract(U& a, const U& b) {
+    a -= b;
+  }
+
+  template <typename U>
+  static void subtract(accumulators::weighted_sum<U>& a,
+                       const accumulators::weighted_sum<U>& b) {
+    a = accumulators::weighted_sum<U>(a.value() - b.value(), a.variance() - b.variance());
+  }
+
+  // recomputes cumulative sums from slice first of the last axis
+  void accumulate(int first, unsigned nthreads) {
+    const unsigned n = rank();
+    const auto& last = axes_.back();
+    // copy values, table entries with any coordinate equal to zero stay zero
+    std::size_t k[axis::limit];
+    std::size_t j = 0;
+    const auto i0 = static_cast<std::size_t>(first) * last.stride[0];
+    for (unsigned r = 0; r < n; ++r) {
+      const auto& d = axes_[r];
+      k[r] = i0 / d.stride[0] % static_cast<std::size_t>(d.extent);
+      j += (k[r] + 1) * d.stride[1];
+    }
+    for (std::size_t i = i0; i < values_.size(); ++i) {
+      table_[j] = values_[i];
+      for (unsigned r = 0; r < n; ++r) {
+        const auto& d = axes_[r];
+        j += d.stride[1];
+        if (++k[r] < static_cast<std::size_t>(d.extent)) break;
+        j -= d.extent * d.stride[1];
+        k[r] = 0;
+      }
+    }
+
+    // cumulative sums along each axis, which are independent for each line of bins
+    nthreads = detail::resolve_threads(nthreads);
+    const auto nmax = std::max(
+        (table_.size() - (first + 1) * last.stride[1]) / detail::map_parallel_min_bins,
+        std::size_t(1));
+    if (nmax < nthreads) nthreads = static_cast<unsigned>(nmax);
+    for (unsigned r = 0; r < n; ++r) {
+      const auto& d = axes_[r];
+      const auto block = d.stride[1] * (d.extent + 1);
+      const auto h0 = r + 1 < n ? (first + 1) * last.stride[1] / block : 0;
+      const auto h1 = table_.size() / block;
+      const auto c0 = r + 1 < n ? 1 : static_cast<std::size_t>(first) + 1;
+      // split lines between threads along the outer or the inner dimension
+      const bool outer = h1 - h0 >= nthreads;
+      const auto m = outer ? h1 - h0 : d.stride[1];
+      auto scan = [&, r](unsigned t) {
+        const auto begin = m * t / nthreads, end = m * (t + 1) / nthreads;
+        accumulate_lines(r, c0, outer ? h0 + begin : h0, outer ? h0 + end : h1,
+                         outer ? 0 : begin, outer ? d.stride[1] : end);
+      };
+      if (nthreads == 1) {
+        scan(0);
+      } else {
+        std::vector<unsigned> ts(nthreads);
+        for (unsigned t = 0; t < nthreads; ++t) ts[t] = t;
+        detail::run_parallel(ts, scan);
+      }
+    }
+  }
+
+  // cumulative sums along axis r from coordinate c0, for blocks [h0, h1) of the outer
+  // axes and offsets [l0, l1) of the inner axes
+  void accumulate_lines(unsigned r, std::size_t c0, std::size_t h0, std::size_t h1,
+                        std::size_t l0, std::size_t l1) {
+    const auto& d = axes_[r];
+    const auto s = d.stride[1];
+    const auto nc = static_cast<std::size_t>(d.extent) + 1;
+    for (auto h = h0; h < h1; ++h) {
+      auto base = table_.data() + h * s * nc;
+      for (auto c = c0; c < nc; ++c) {
+        auto cur = base + c * s;
+        const auto prev = cur - s;
+        for (auto l = l0; l < l1; ++l) cur[l] += prev[l];
+      }
+    }
+  }
+
+  axes_type axes_;
+  std::vector<value_type> values_, table_;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
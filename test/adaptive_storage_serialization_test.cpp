@@ -8,6 +8,7 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/core/lightweight_test.hpp>
 #include <boost/histogram/adaptive_storage.hpp>
+#include <boost/histogram/chunked_adaptive_storage.hpp>
 #include <boost/histogram/serialization.hpp>
 #include <memory>
 #include <sstream>
@@ -83,5 +84,30 @@ int main() {
     serialization_impl<double>();
   }
 
+  // chunked_adaptive_storage
+  {
+    chunked_adaptive_storage<adaptive_storage_type::allocator_type, 2> a, b;
+    a.reset(5);
+    a(0);
+    for (unsigned k = 0; k < 300; ++k) a(3);
+    a(4, weight(0.5));
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << a;
+      buf = os.str();
+    }
+    BOOST_TEST(!(a == b));
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST_EQ(b.chunks.size(), 3);
+    BOOST_TEST_EQ(b[3], 300);
+  }
+
   return boost::report_errors();
 }
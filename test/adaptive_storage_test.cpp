@@ -122,6 +122,69 @@ void increase_and_grow_impl<void>() {
   BOOST_TEST_EQ(s[1], 0);
 }
 
+template <typename T>
+void increment_n_impl() {
+  // first counter overflows in the middle of the batch, if T is a small integer
+  auto s = prepare(3, static_cast<T>(std::numeric_limits<T>::max() - 1));
+  auto ref = s;
+  const std::size_t idx[] = {1, 0, 2, 0, 0, 1};
+  for (auto i : idx) ref(i);
+  s.increment_n(idx, 6);
+  BOOST_TEST(s == ref);
+  BOOST_TEST_EQ(s[1], 2);
+  BOOST_TEST_EQ(s[2], 1);
+  s.increment_n(idx, 0);
+  BOOST_TEST(s == ref);
+}
+
+template <typename T>
+void insert_zeros_impl() {
+  auto s = prepare(3, static_cast<T>(2));
+  s(2);
+  const auto type = s.buffer.type;
+  s.insert_zeros(1, 2);
+  BOOST_TEST_EQ(s.size(), 5);
+  BOOST_TEST_EQ(s[0], 2);
+  BOOST_TEST_EQ(s[1], 0);
+  BOOST_TEST_EQ(s[2], 0);
+  BOOST_TEST_EQ(s[3], 0);
+  BOOST_TEST_EQ(s[4], 1);
+  BOOST_TEST_EQ(s.buffer.type, type);
+  // capacity grows geometrically, small insertions then stay in place
+  BOOST_TEST_EQ(s.buffer.capacity, 6);
+  const auto ptr = s.buffer.ptr;
+  s.insert_zeros(4, 1);
+  BOOST_TEST_EQ(s.buffer.ptr, ptr);
+  BOOST_TEST_EQ(s.size(), 6);
+  BOOST_TEST_EQ(s[3], 0);
+  BOOST_TEST_EQ(s[4], 0);
+  BOOST_TEST_EQ(s[5], 1);
+  s(3);
+  BOOST_TEST_EQ(s[3], 1);
+  auto c = s;
+  BOOST_TEST(c == s);
+}
+
+template <>
+void insert_zeros_impl<void>() {
+  auto s = prepare<void>(3);
+  s.insert_zeros(3, 2);
+  BOOST_TEST_EQ(s.size(), 5);
+  BOOST_TEST_EQ(s.buffer.type, 0);
+  s(4);
+  BOOST_TEST_EQ(s[4], 1);
+}
+
+template <>
+void increment_n_impl<void>() {
+  auto s = prepare<void>(3);
+  const std::size_t idx[] = {2, 0, 2};
+  s.increment_n(idx, 3);
+  BOOST_TEST_EQ(s[0], 1);
+  BOOST_TEST_EQ(s[1], 0);
+  BOOST_TEST_EQ(s[2], 2);
+}
+
 template <typename T>
 void convert_array_storage_impl() {
   const auto aref = prepare(1, T(0));
@@ -324,6 +387,35 @@ int main() {
     BOOST_TEST_EQ(a[1], 0);
   }
 
+  // increment_n
+  {
+    increment_n_impl<void>();
+    increment_n_impl<uint8_t>();
+    increment_n_impl<uint16_t>();
+    increment_n_impl<uint32_t>();
+    increment_n_impl<uint64_t>();
+
+    auto a = prepare<adaptive_storage_type::mp_int>(2, 1);
+    auto b = prepare<double>(2, 1);
+    const std::size_t idx[] = {0, 1, 0};
+    a.increment_n(idx, 3);
+    b.increment_n(idx, 3);
+    BOOST_TEST_EQ(a[0], 3);
+    BOOST_TEST_EQ(a[1], 1);
+    BOOST_TEST(a == b);
+  }
+
+  // insert_zeros
+  {
+    insert_zeros_impl<void>();
+    insert_zeros_impl<uint8_t>();
+    insert_zeros_impl<uint16_t>();
+    insert_zeros_impl<uint32_t>();
+    insert_zeros_impl<uint64_t>();
+    insert_zeros_impl<adaptive_storage_type::mp_int>();
+    insert_zeros_impl<double>();
+  }
+
   // add
   {
     add_impl_all_rhs<void>();
@@ -0,0 +1,101 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram.hpp>
+#include <boost/histogram/algorithm/fill_parallel.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <stdexcept>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+using boost::histogram::algorithm::fill_parallel;
+
+template <typename Tag>
+void run_tests() {
+  // enough values for several blocks per thread, most go into a few bins
+  std::vector<int> x, y;
+  std::vector<double> w;
+  for (int i = 0; i < 10000; ++i) {
+    x.push_back(i % 7 ? 3 : i % 12 - 1);
+    y.push_back(i % 5);
+    w.push_back(0.5 * (i % 3));
+  }
+
+  // 1D and 2D with adaptive storage
+  for (unsigned nthreads : {0, 1, 2, 3, 5, 8}) {
+    auto h1 = make(Tag(), axis::integer<>(0, 10));
+    auto h2 = h1;
+    h1.fill(x);
+    fill_parallel(h2, nthreads, x);
+    BOOST_TEST(h1 == h2);
+
+    auto h3 = make(Tag(), axis::integer<>(0, 10), axis::integer<>(0, 4));
+    auto h4 = h3;
+    h3.fill(x, y);
+    fill_parallel(h4, nthreads, x, y);
+    BOOST_TEST(h3 == h4);
+
+    // weighted fill
+    h3.fill(weight(w), x, y);
+    fill_parallel(h4, nthreads, weight(w), x, y);
+    BOOST_TEST(h3 == h4);
+  }
+
+  // vector storage, existing counts are kept
+  {
+    auto h1 = make_s(Tag(), std::vector<int>(), axis::integer<>(0, 10));
+    h1(3);
+    auto h2 = h1;
+    h1.fill(x);
+    fill_parallel(h2, 4, x);
+    BOOST_TEST(h1 == h2);
+    BOOST_TEST_EQ(h2.at(3), 1 + std::count(x.begin(), x.end(), 3));
+  }
+
+  // fewer samples than threads
+  {
+    auto h = make(Tag(), axis::integer<>(0, 10));
+    fill_parallel(h, 16, std::vector<int>{1, 2, 2});
+    BOOST_TEST_EQ(h.at(1), 1);
+    BOOST_TEST_EQ(h.at(2), 2);
+    fill_parallel(h, 16, std::vector<int>());
+    BOOST_TEST_EQ(h.at(2), 2);
+  }
+
+  // spans of different length
+  {
+    auto h = make(Tag(), axis::integer<>(0, 10), axis::integer<>(0, 4));
+    BOOST_TEST_THROWS(fill_parallel(h, 2, x, std::vector<int>(3)),
+                      std::invalid_argument);
+  }
+
+  // axes which grow are not supported
+  {
+    auto h = make(Tag(), axis::integer<>(0, 10),
+                  axis::regular<>(2, 0, 1, "", axis::option_type::growth));
+    std::vector<double> z(x.size(), 2.5);
+    BOOST_TEST_THROWS(fill_parallel(h, 2, x, z), std::invalid_argument);
+    BOOST_TEST_EQ(h.axis(1).size(), 2);
+    BOOST_TEST_EQ(algorithm::sum(h), 0);
+  }
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  // wrong number of arguments
+  {
+    auto h = make(dynamic_tag(), axis::integer<>(0, 10));
+    std::vector<int> x(10);
+    BOOST_TEST_THROWS(fill_parallel(h, 2, x, x), std::invalid_argument);
+  }
+
+  return boost::report_errors();
+}
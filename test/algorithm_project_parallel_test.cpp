@@ -0,0 +1,65 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/project.hpp>
+#include <boost/histogram/algorithm/project_parallel.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/ostream_operators.hpp>
+#include <boost/histogram/literals.hpp>
+#include <stdexcept>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+using namespace boost::histogram::literals; // to get _c suffix
+using namespace boost::histogram::algorithm;
+
+template <typename Tag>
+void run_tests() {
+  // enough bins for several threads, counts differ between bins
+  auto h = make(Tag(), axis::integer<>(0, 100), axis::integer<>(0, 60),
+                axis::integer<>(0, 30));
+  for (int i = 0; i < 20000; ++i) h(i % 103 - 1, i % 61, i % 29 + i % 3);
+
+  for (unsigned nthreads : {0, 1, 2, 3, 5, 8}) {
+    BOOST_TEST(project_parallel(h, nthreads, 0_c) == project(h, 0_c));
+    BOOST_TEST(project_parallel(h, nthreads, 2_c) == project(h, 2_c));
+    BOOST_TEST(project_parallel(h, nthreads, 1_c, 2_c) == project(h, 1_c, 2_c));
+    BOOST_TEST(project_parallel(h, nthreads, 2_c, 0_c) == project(h, 2_c, 0_c));
+  }
+
+  // small histogram, projected in one thread
+  {
+    auto h2 = make(Tag(), axis::integer<>(0, 2), axis::integer<>(0, 3));
+    h2(0, 0);
+    h2(1, 2);
+    h2(1, 2);
+    auto hy = project_parallel(h2, 4, 1_c);
+    BOOST_TEST_EQ(hy.at(0), 1);
+    BOOST_TEST_EQ(hy.at(2), 2);
+  }
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  {
+    auto h = make(dynamic_tag(), axis::integer<>(0, 300), axis::integer<>(0, 400));
+    for (int i = 0; i < 1000; ++i) h(i % 300, i % 401);
+
+    std::vector<int> x = {1, 0};
+    BOOST_TEST(project_parallel(h, 3, x) == project(h, x));
+    x = {1};
+    BOOST_TEST(project_parallel(h, 3, x) == project(h, x));
+
+    x = {0, 0};
+    BOOST_TEST_THROWS(project_parallel(h, 3, x), std::invalid_argument);
+  }
+
+  return boost::report_errors();
+}
@@ -132,6 +132,39 @@ void run_tests() {
     BOOST_TEST_EQ(h_210.at(2, 0, 0), 1);
     BOOST_TEST_EQ(h_210.at(2, 0, 1), 1);
   }
+
+  // flow bins are summed over, for kept prefix, kept suffix, and other selections
+  {
+    auto h = make(Tag(), axis::integer<>(0, 2), axis::integer<>(0, 3),
+                  axis::integer<>(0, 2, "", axis::option_type::none));
+    for (int i = -1; i < 3; ++i)
+      for (int j = -1; j < 4; ++j)
+        for (int k = 0; k < 2; ++k)
+          for (int n = 0; n < 2 + i + j * k; ++n) h(i, j, k);
+
+    auto sum_at = [&h](int i, int j, int k) {
+      double s = 0;
+      for (int a = -1; a < 3; ++a)
+        for (int b = -1; b < 4; ++b)
+          for (int c = 0; c < 2; ++c)
+            if ((i == 9 || i == a) && (j == 9 || j == b) && (k == 9 || k == c))
+              s += h.at(a, b, c);
+      return s;
+    };
+
+    auto h_01 = project(h, 0_c, 1_c);
+    auto h_12 = project(h, 1_c, 2_c);
+    auto h_1 = project(h, 1_c);
+    auto h_20 = project(h, 2_c, 0_c);
+    for (int i = -1; i < 3; ++i)
+      for (int j = -1; j < 4; ++j) BOOST_TEST_EQ(h_01.at(i, j), sum_at(i, j, 9));
+    for (int j = -1; j < 4; ++j) {
+      BOOST_TEST_EQ(h_1.at(j), sum_at(9, j, 9));
+      for (int k = 0; k < 2; ++k) BOOST_TEST_EQ(h_12.at(j, k), sum_at(9, j, k));
+    }
+    for (int k = 0; k < 2; ++k)
+      for (int i = -1; i < 3; ++i) BOOST_TEST_EQ(h_20.at(k, i), sum_at(i, 9, k));
+  }
 }
 
 int main() {
@@ -182,5 +215,28 @@ int main() {
     BOOST_TEST_THROWS(project(h, x), std::invalid_argument);
   }
 
+  // project_many agrees with project
+  {
+    auto h = make(dynamic_tag(), axis::integer<>(0, 2), axis::integer<>(0, 3),
+                  axis::integer<>(0, 4, "", axis::option_type::none));
+    for (int i = 0; i < 100; ++i) h(i % 4 - 1, i % 5 - 1, i % 4);
+
+    std::vector<std::vector<int>> xs = {{0}, {1}, {2}, {0, 1}, {2, 0}, {1, 2}, {2, 1, 0}};
+    auto hs = project_many(h, xs);
+    BOOST_TEST_EQ(hs.size(), xs.size());
+    for (std::size_t i = 0; i < xs.size(); ++i) BOOST_TEST(hs[i] == project(h, xs[i]));
+
+    // first axis longer than a chunk of the single pass
+    auto h2 = make(dynamic_tag(), axis::integer<>(0, 1000), axis::integer<>(0, 3));
+    for (int i = 0; i < 3000; ++i) h2(i % 1003 - 1, i % 4);
+    xs = {{0}, {1}, {1, 0}};
+    auto hs2 = project_many(h2, xs);
+    for (std::size_t i = 0; i < xs.size(); ++i) BOOST_TEST(hs2[i] == project(h2, xs[i]));
+
+    BOOST_TEST(project_many(h, std::vector<std::vector<int>>()).empty());
+    xs = {{0}, {1, 1}};
+    BOOST_TEST_THROWS(project_many(h, xs), std::invalid_argument);
+  }
+
   return boost::report_errors();
 }
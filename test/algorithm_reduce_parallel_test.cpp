@@ -0,0 +1,46 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/reduce.hpp>
+#include <boost/histogram/algorithm/reduce_parallel.hpp>
+#include <boost/histogram/axis/ostream_operators.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <stdexcept>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+using namespace boost::histogram::algorithm;
+
+template <typename Tag>
+void run_tests() {
+  // enough bins for several threads, counts differ between bins
+  auto h = make(Tag(), axis::regular<>(100, 0, 100), axis::regular<>(60, 0, 60),
+                axis::regular<>(30, 0, 30));
+  for (int i = 0; i < 20000; ++i) h(i % 103 - 1.5, i % 61, i % 29 + i % 3);
+
+  for (unsigned nthreads : {0, 1, 2, 3, 5, 8}) {
+    BOOST_TEST(reduce_parallel(h, nthreads, rebin(0, 4)) == reduce(h, rebin(0, 4)));
+    BOOST_TEST(reduce_parallel(h, nthreads, shrink(0, 10, 50), rebin(2, 3)) ==
+               reduce(h, shrink(0, 10, 50), rebin(2, 3)));
+    BOOST_TEST(reduce_parallel(h, nthreads, shrink_and_rebin(1, 2, 40, 2)) ==
+               reduce(h, shrink_and_rebin(1, 2, 40, 2)));
+  }
+
+  std::vector<reduce_option_type> opts = {shrink(0, 10, 50), rebin(1, 5)};
+  BOOST_TEST(reduce_parallel(h, 3, opts) == reduce(h, opts));
+
+  BOOST_TEST_THROWS(reduce_parallel(h, 2, rebin(0, 2), rebin(0, 2)),
+                    std::invalid_argument);
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  return boost::report_errors();
+}
@@ -12,6 +12,8 @@
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include "utility_axis.hpp"
 
 using namespace boost::histogram;
@@ -54,6 +56,80 @@ int main() {
     BOOST_TEST_THROWS(a.value(3), std::out_of_range);
   }
 
+  // axis::category with hash index
+  {
+    std::vector<int> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(7 * i - 500);
+    v.push_back(-500); // duplicate is mapped to first occurrence
+    axis::category<> a(v);
+    for (int i = 0; i < 1000; ++i) BOOST_TEST_EQ(a(7 * i - 500), i);
+    BOOST_TEST_EQ(a(-499), 1001);
+    BOOST_TEST_EQ(a(1 << 30), 1001);
+
+    auto b = a;
+    BOOST_TEST_EQ(b(4), 72);
+    auto c = axis::category<>({1, 2});
+    c = a;
+    BOOST_TEST_EQ(c(4), 72);
+    auto d = std::move(c);
+    BOOST_TEST_EQ(d(4), 72);
+    auto e = axis::category<>({1, 2});
+    e = std::move(d);
+    BOOST_TEST_EQ(e(4), 72);
+    BOOST_TEST_EQ(e(1), 1001);
+
+    std::vector<std::string> s;
+    for (int i = 0; i < 100; ++i) s.push_back(std::to_string(i));
+    axis::category<std::string> f(s);
+    BOOST_TEST_EQ(f("42"), 42);
+    BOOST_TEST_EQ(f("foo"), 100);
+  }
+
+  // shrink
+  {
+    auto a = axis::category<>({5, 1, 3, 7});
+    auto b = axis::category<>(a, 1, 3, 1);
+    BOOST_TEST_EQ(b, axis::category<>({1, 3}));
+    BOOST_TEST_THROWS(axis::category<>(a, 0, 4, 2), std::invalid_argument);
+
+    std::vector<int> v(100);
+    for (unsigned i = 0; i < v.size(); ++i) v[i] = i;
+    auto c = axis::category<>(axis::category<>(v), 50, 100, 1);
+    BOOST_TEST_EQ(c.size(), 50);
+    BOOST_TEST_EQ(c(49), 50);
+    BOOST_TEST_EQ(c(50), 0);
+    BOOST_TEST_EQ(c(99), 49);
+  }
+
+  // growth
+  {
+    using O = axis::option_type;
+    auto a = axis::category<std::string>({"A"}, "", O::overflow | O::growth);
+    BOOST_TEST(a.update("A") == std::make_pair(0, 0));
+    BOOST_TEST(a.update("B") == std::make_pair(1, 0));
+    BOOST_TEST_EQ(a.size(), 2);
+    BOOST_TEST_EQ(a.value(1), "B");
+    BOOST_TEST_EQ(a("B"), 1);
+    BOOST_TEST_EQ(a("C"), 2);
+
+    // passes the threshold for the hash index and rebuilds it several times
+    auto b = axis::category<>({0}, "", O::growth);
+    for (int i = 0; i < 100; ++i) BOOST_TEST_EQ(b.update(3 * i).first, i);
+    BOOST_TEST_EQ(b.size(), 100);
+    for (int i = 0; i < 100; ++i) BOOST_TEST_EQ(b(3 * i), i);
+    BOOST_TEST_EQ(b(1), 100);
+    auto c = b;
+    BOOST_TEST_EQ(c, b);
+    c = axis::category<>({1, 2});
+    c = b;
+    BOOST_TEST_EQ(c, b);
+    BOOST_TEST_EQ(c(297), 99);
+
+    auto d = axis::category<>({0});
+    BOOST_TEST(d.update(1) == std::make_pair(1, 0));
+    BOOST_TEST_EQ(d.size(), 1);
+  }
+
   // iterators
   {
     test_axis_iterator(axis::category<>({3, 1, 2}, ""), 0, 3);
@@ -8,6 +8,7 @@
 #include <boost/histogram/axis/circular.hpp>
 #include <boost/histogram/axis/ostream_operators.hpp>
 #include <limits>
+#include <vector>
 #include "utility_axis.hpp"
 
 using namespace boost::histogram;
@@ -46,6 +47,27 @@ int main() {
     BOOST_TEST_EQ(a(std::numeric_limits<double>::quiet_NaN()), 4);
   }
 
+  // index_n agrees with operator(), also far from the first period
+  {
+    const auto a = axis::circular<>(36, 1.5);
+    std::vector<double> x = {std::numeric_limits<double>::infinity(),
+                             std::numeric_limits<double>::quiet_NaN(), -1e300, 1e300};
+    for (int i = -1000; i < 1000; ++i) x.push_back(1.5 + 0.0123 * i * i);
+    for (int i = 0; i <= 36; ++i) x.push_back(a.value(i) - 1e-12);
+    std::vector<int> out(x.size(), -42);
+    a.index_n(x.data(), out.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      BOOST_TEST_EQ(out[i], a(x[i]));
+      BOOST_TEST_GE(out[i], 0);
+      BOOST_TEST_LE(out[i], 36);
+    }
+    BOOST_TEST_EQ(a(a.value(3) - 1e-12), 2);
+    BOOST_TEST_EQ(a(a.value(3) + 1e-12), 3);
+    BOOST_TEST_EQ(a(1.5 - 1e-15), 35);
+    BOOST_TEST_EQ(a(1e300), a(-1e300));
+    BOOST_TEST_LT(a(1e300), 36);
+  }
+
   // iterators
   { test_axis_iterator(axis::circular<>(5, 0, 1, ""), 0, 5); }
 
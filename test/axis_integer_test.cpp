@@ -14,9 +14,11 @@
 #include <boost/histogram/axis/variant.hpp>
 #include <boost/histogram/detail/axes.hpp>
 #include <boost/histogram/detail/meta.hpp>
+#include <cmath>
 #include <limits>
 #include <sstream>
 #include <type_traits>
+#include <vector>
 #include "utility_axis.hpp"
 
 using namespace boost::histogram;
@@ -68,6 +70,34 @@ int main() {
     BOOST_TEST_EQ(a(10), 3);
   }
 
+  // extreme values and NaN
+  {
+    axis::integer<int> a{-1, 2};
+    BOOST_TEST_EQ(a(std::numeric_limits<int>::min()), -1);
+    BOOST_TEST_EQ(a(std::numeric_limits<int>::max()), 3);
+    axis::integer<> b{-1, 2};
+    BOOST_TEST_EQ(b(-1.5), -1);
+    BOOST_TEST_EQ(b(1.5), 2);
+    BOOST_TEST_EQ(b(1e300), 3);
+    BOOST_TEST_EQ(b(-std::numeric_limits<double>::infinity()), -1);
+    BOOST_TEST_EQ(b(std::numeric_limits<double>::quiet_NaN()), 3);
+  }
+
+  // index_n agrees with operator()
+  {
+    auto test = [](const auto& a, auto x) {
+      std::vector<int> out(x.size(), -42);
+      a.index_n(x.data(), out.data(), x.size());
+      for (std::size_t i = 0; i < x.size(); ++i) BOOST_TEST_EQ(out[i], a(x[i]));
+    };
+    test(axis::integer<int>(-3, 5), std::vector<int>{std::numeric_limits<int>::min(),
+                                                     -4, -3, 0, 4, 5, 6, 100,
+                                                     std::numeric_limits<int>::max()});
+    test(axis::integer<unsigned>(2, 5), std::vector<unsigned>{0, 1, 2, 3, 4, 5, 6, 100});
+    test(axis::integer<>(-3, 5),
+         std::vector<double>{-4, -3.5, -3, 0.5, 4.9, 5, std::nan(""), 1e300});
+  }
+
   // iterators
   { test_axis_iterator(axis::integer<>(0, 4, ""), 0, 4); }
 
@@ -0,0 +1,158 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/reduce.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
+#include <boost/histogram/axis/ostream_operators.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/variant.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "utility_axis.hpp"
+
+using namespace boost::histogram;
+
+int main() {
+  // bad_ctors
+  {
+    using A = axis::log_linear<>;
+    BOOST_TEST_THROWS(A(0, 1, 2), std::invalid_argument);
+    BOOST_TEST_THROWS(A(3, 1, 2), std::invalid_argument);
+    BOOST_TEST_THROWS(A(4, 0, 2), std::invalid_argument);
+    BOOST_TEST_THROWS(A(4, 2, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(A(4, 1, std::numeric_limits<double>::infinity()),
+                      std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<float>(1u << 24, 1, 2), std::invalid_argument);
+    BOOST_TEST_THROWS(A(1u << 30, 1e-300, 1e300), std::invalid_argument);
+    BOOST_TEST_THROWS(A(4, 1, 2, "", axis::option_type::growth), std::invalid_argument);
+  }
+
+  // axis::log_linear
+  {
+    axis::log_linear<> a{4, 1, 16, "foo"};
+    BOOST_TEST_EQ(a.size(), 16);
+    BOOST_TEST_EQ(a.subbins(), 4);
+    BOOST_TEST_EQ(a.metadata(), "foo");
+    BOOST_TEST_EQ(a[-1].lower(), -std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a[0].lower(), 1);
+    BOOST_TEST_EQ(a[0].upper(), 1.25);
+    BOOST_TEST_EQ(a[0].center(), 1.125);
+    BOOST_TEST_EQ(a[4].lower(), 2);
+    BOOST_TEST_EQ(a[5].lower(), 2.5);
+    BOOST_TEST_EQ(a[15].lower(), 14);
+    BOOST_TEST_EQ(a[16].lower(), 16);
+    BOOST_TEST_EQ(a[16].upper(), std::numeric_limits<double>::infinity());
+
+    BOOST_TEST_EQ(a(-1), -1);
+    BOOST_TEST_EQ(a(0), -1);
+    BOOST_TEST_EQ(a(0.99), -1);
+    BOOST_TEST_EQ(a(1), 0);
+    BOOST_TEST_EQ(a(1.24), 0);
+    BOOST_TEST_EQ(a(1.25), 1);
+    BOOST_TEST_EQ(a(2), 4);
+    BOOST_TEST_EQ(a(3.1), 6);
+    BOOST_TEST_EQ(a(15.9), 15);
+    BOOST_TEST_EQ(a(16), 16);
+    BOOST_TEST_EQ(a(-std::numeric_limits<double>::infinity()), -1);
+    BOOST_TEST_EQ(a(std::numeric_limits<double>::infinity()), 16);
+    BOOST_TEST_EQ(a(std::numeric_limits<double>::quiet_NaN()), 16);
+
+    axis::log_linear<> b;
+    BOOST_TEST_NE(a, b);
+    b = a;
+    BOOST_TEST_EQ(a, b);
+    BOOST_TEST_NE(a, axis::log_linear<>(8, 1, 16, "foo"));
+
+    std::ostringstream os;
+    os << a;
+    BOOST_TEST_EQ(os.str(), "log_linear(4, 1, 16, metadata=\"foo\", "
+                            "options=underflow_and_overflow)");
+  }
+
+  // range is widened to bin edges, relative bin width is bounded
+  {
+    axis::log_linear<float> a(8, 3, 1000, "", axis::option_type::overflow);
+    BOOST_TEST_EQ(a.value(0), 3);
+    BOOST_TEST_EQ(a.value(a.size()), 1024);
+    BOOST_TEST_EQ(a(2.9f), -1);
+    for (auto&& bin : a) BOOST_TEST_LE(bin.width() / bin.lower(), 1.0 / 8);
+
+    axis::log_linear<> b(2, 0.3, 5);
+    BOOST_TEST_EQ(b.value(0), 0.25);
+    BOOST_TEST_EQ(b.value(1), 0.375);
+    BOOST_TEST_EQ(b.value(b.size()), 6);
+  }
+
+  // index_n agrees with operator()
+  {
+    auto test = [](const auto& a) {
+      using T = std::decay_t<decltype(a.value(0))>;
+      const T inf = std::numeric_limits<T>::infinity();
+      std::vector<T> x = {-inf, inf, std::numeric_limits<T>::quiet_NaN(), -1, 0, 1e-30f};
+      for (int i = -1, n = a.size(); i <= n + 1; ++i) {
+        x.push_back(a.value(i));
+        x.push_back(a.value(i + 0.5));
+        x.push_back(std::nextafter(a.value(i), T(0)));
+      }
+      std::vector<int> out(x.size(), -42);
+      a.index_n(x.data(), out.data(), x.size());
+      for (std::size_t i = 0; i < x.size(); ++i) BOOST_TEST_EQ(out[i], a(x[i]));
+    };
+
+    test(axis::log_linear<>(4, 1, 16));
+    test(axis::log_linear<>(32, 1e-3, 1e3, "", axis::option_type::none));
+    test(axis::log_linear<float>(16, 0.1f, 100));
+  }
+
+  // iterators
+  {
+    test_axis_iterator(axis::log_linear<>(2, 1, 8, "", axis::option_type::none), 0, 6);
+  }
+
+  // shrink and rebin
+  {
+    using A = axis::log_linear<>;
+    auto a = A(4, 1, 16);
+    auto b = A(a, 0, 16, 2);
+    BOOST_TEST_EQ(b, A(2, 1, 16));
+    auto c = A(a, 4, 12, 4);
+    BOOST_TEST_EQ(c, A(1, 2, 8));
+    BOOST_TEST_THROWS(A(a, 0, 15, 3), std::invalid_argument);
+    BOOST_TEST_THROWS(A(a, 0, 16, 8), std::invalid_argument);
+    BOOST_TEST_THROWS(A(a, 1, 15, 2), std::invalid_argument);
+  }
+
+  // histogram, also in variant, and reduce merges sub-bins
+  {
+    auto h = make_histogram(axis::log_linear<>(4, 1, 16));
+    std::vector<double> x = {0.5, 1, 1.3, 2.2, 2.9, 7, 15, 100};
+    h.fill(x);
+    h(3);
+    auto hr = algorithm::reduce(h, algorithm::rebin(2));
+    BOOST_TEST_EQ(hr.axis(), axis::log_linear<>(2, 1, 16));
+    BOOST_TEST_EQ(hr.at(-1), 1);
+    BOOST_TEST_EQ(hr.at(0), 2);
+    BOOST_TEST_EQ(hr.at(2), 2);
+    BOOST_TEST_EQ(hr.at(3), 1);
+    BOOST_TEST_EQ(hr.at(5), 1);
+    BOOST_TEST_EQ(hr.at(7), 1);
+    BOOST_TEST_EQ(hr.at(8), 1);
+
+    using V = axis::variant<axis::regular<>, axis::log_linear<>>;
+    auto h2 = make_histogram(std::vector<V>{axis::log_linear<>(4, 1, 16)});
+    h2.fill(x);
+    h2(3);
+    for (int i = -1; i <= 16; ++i) BOOST_TEST_EQ(h2.at(i), h.at(i));
+  }
+
+  return boost::report_errors();
+}
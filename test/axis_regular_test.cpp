@@ -9,8 +9,12 @@
 #include <boost/histogram/axis/regular.hpp>
 #include <boost/units/quantity.hpp>
 #include <boost/units/systems/si/length.hpp>
+#include <cmath>
 #include <limits>
 #include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "is_close.hpp"
 #include "utility_axis.hpp"
 
@@ -134,6 +138,127 @@ int main() {
     BOOST_TEST_EQ(b(std::numeric_limits<double>::infinity() * meter), 2);
   }
 
+  // index_n agrees with operator()
+  {
+    auto test = [](const auto& a) {
+      const double inf = std::numeric_limits<double>::infinity();
+      const double nan = std::numeric_limits<double>::quiet_NaN();
+      std::vector<double> x = {-inf, inf, nan, -1, 0, 1e-300, 1, 4, 100};
+      for (int i = -30; i < 30; ++i) x.push_back(0.25 * i);
+      for (int i = -1, n = a.size(); i <= n + 1; ++i) x.push_back(a.value(i));
+      std::vector<int> out(x.size(), -42);
+      a.index_n(x.data(), out.data(), x.size());
+      for (std::size_t i = 0; i < x.size(); ++i) BOOST_TEST_EQ(out[i], a(x[i]));
+    };
+
+    test(axis::regular<>(4, -2, 2));
+    test(axis::regular<>(2, 1, -2));
+    test(axis::regular<>(1, 0, 1, "", axis::option_type::none));
+    test(axis::regular<axis::transform::log<>>(2, 1e0, 1e2));
+    test(axis::regular<axis::transform::sqrt<>>(2, 0, 4));
+    test(axis::regular<axis::transform::pow<>>(axis::transform::pow<>(0.5), 3, 1, 4));
+    test(axis::regular<>(3, -2, 2, "", axis::option_type::reciprocal));
+    test(axis::regular<>(
+        5, 1, -2, "", axis::option_type::overflow | axis::option_type::reciprocal));
+  }
+
+  // index_n with approximate transform agrees with operator() also at bin edges
+  {
+    auto test = [](const auto& a) {
+      using T = std::decay_t<decltype(a.value(0))>;
+      std::vector<T> x = {0, -1, std::numeric_limits<T>::infinity(),
+                          std::numeric_limits<T>::quiet_NaN()};
+      for (int i = -2, n = a.size(); i <= n + 2; ++i) {
+        const T v = a.value(i);
+        x.push_back(v);
+        x.push_back(std::nextafter(v, T(0)));
+        x.push_back(std::nextafter(v, std::numeric_limits<T>::max()));
+        x.push_back(a.value(i + 0.5));
+      }
+      std::vector<int> out(x.size(), -42);
+      a.index_n(x.data(), out.data(), x.size());
+      for (std::size_t i = 0; i < x.size(); ++i) BOOST_TEST_EQ(out[i], a(x[i]));
+    };
+
+    using O = axis::option_type;
+    test(axis::regular<axis::transform::log<>>(7, 1e-3, 1e5));
+    test(axis::regular<axis::transform::log<>>(7, 1e-3, 1e5, "", O::reciprocal));
+    test(axis::regular<axis::transform::log<float>>(10, 1, 1e3));
+    test(axis::regular<axis::transform::pow<>>(axis::transform::pow<>(2), 10, 0, 3));
+    test(axis::regular<axis::transform::pow<>>(axis::transform::pow<>(-1.5), 5, 1, 9));
+  }
+
+  // reciprocal and single precision
+  {
+    using O = axis::option_type;
+    auto a = axis::regular<>(4, -2, 2, "foo", O::underflow_and_overflow | O::reciprocal);
+    BOOST_TEST_EQ(a(-10.), -1);
+    BOOST_TEST_EQ(a(-2.0), 0);
+    BOOST_TEST_EQ(a(-1.1), 0);
+    BOOST_TEST_EQ(a(0.5), 2);
+    BOOST_TEST_EQ(a(1.9), 3);
+    BOOST_TEST_EQ(a(10.), 4);
+    BOOST_TEST_EQ(a(std::numeric_limits<double>::quiet_NaN()), 4);
+    BOOST_TEST_NE(a, axis::regular<>(4, -2, 2, "foo"));
+
+    // away from the bin edges, bins are the same as with division
+    const auto b = axis::regular<>(10, -1, 2);
+    const auto c =
+        axis::regular<>(10, -1, 2, "", O::underflow_and_overflow | O::reciprocal);
+    for (int i = -5; i < 105; ++i) {
+      const double x = -1 + 0.03 * (i + 0.5);
+      BOOST_TEST_EQ(b(x), c(x));
+    }
+
+    std::ostringstream os;
+    os << a;
+    BOOST_TEST_EQ(os.str(), "regular(4, -2, 2, metadata=\"foo\", "
+                            "options=underflow_and_overflow | reciprocal)");
+
+    // computes in float, index_n is used for spans of floats
+    using F = axis::regular<axis::transform::identity<float>>;
+    const auto f = F(4, -2, 2, "", O::underflow_and_overflow | O::reciprocal);
+    BOOST_TEST_EQ(f(-1.5f), 0);
+    BOOST_TEST_EQ(f(1.5f), 3);
+    BOOST_TEST_EQ(f(2.5f), 4);
+    BOOST_TEST_EQ(f.value(1), -1.f);
+    std::vector<float> x = {-3.f, -2.f, -0.5f, 0.f, 1.25f, 2.f, 3.f};
+    std::vector<int> out(x.size());
+    f.index_n(x.data(), out.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) BOOST_TEST_EQ(out[i], f(x[i]));
+  }
+
+  // growth
+  {
+    using O = axis::option_type;
+    auto a = axis::regular<>(2, 0, 1, "", O::underflow_and_overflow | O::growth);
+    BOOST_TEST(axis::traits::growth(a));
+    BOOST_TEST(a.update(0.6) == std::make_pair(1, 0));
+    BOOST_TEST_EQ(a.size(), 2);
+    // grows at least by the current size
+    BOOST_TEST(a.update(1.2) == std::make_pair(2, 0));
+    BOOST_TEST_EQ(a.size(), 4);
+    BOOST_TEST_EQ(a.value(4), 2);
+    BOOST_TEST(a.update(-0.1) == std::make_pair(3, 4));
+    BOOST_TEST_EQ(a.size(), 8);
+    BOOST_TEST_EQ(a.value(0), -2);
+    BOOST_TEST(a.update(9.9) == std::make_pair(23, 0));
+    BOOST_TEST_EQ(a.size(), 24);
+    BOOST_TEST_EQ(a.value(24), 10);
+    // values which cannot grow the axis
+    const double inf = std::numeric_limits<double>::infinity();
+    BOOST_TEST(a.update(inf) == std::make_pair(24, 0));
+    BOOST_TEST(a.update(-inf) == std::make_pair(-1, 0));
+    BOOST_TEST(a.update(std::numeric_limits<double>::quiet_NaN()) ==
+               std::make_pair(24, 0));
+    BOOST_TEST_EQ(a.size(), 24);
+
+    auto b = axis::regular<>(2, 0, 1);
+    BOOST_TEST_NOT(axis::traits::growth(b));
+    BOOST_TEST(b.update(1.2) == std::make_pair(2, 0));
+    BOOST_TEST_EQ(b.size(), 2);
+  }
+
   // iterators
   {
     test_axis_iterator(axis::regular<>(5, 0, 1, "", axis::option_type::none), 0, 5);
@@ -0,0 +1,131 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/reduce.hpp>
+#include <boost/histogram/axis/ostream_operators.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/axis/variant.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <limits>
+#include <ratio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "utility_axis.hpp"
+
+using namespace boost::histogram;
+
+int main() {
+  // axis::static_regular
+  {
+    using A = axis::static_regular<4, std::ratio<-2>, std::ratio<2>>;
+    A a;
+    BOOST_TEST_EQ(a.size(), 4);
+    BOOST_TEST_EQ(axis::traits::extend(a), 6);
+    BOOST_TEST_EQ(a[-1].lower(), -std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a[0].lower(), -2);
+    BOOST_TEST_EQ(a[1].lower(), -1);
+    BOOST_TEST_EQ(a[a.size()].lower(), 2);
+    BOOST_TEST_EQ(a[a.size()].upper(), std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a(-10.), -1);
+    BOOST_TEST_EQ(a(-2.1), -1);
+    BOOST_TEST_EQ(a(-2.0), 0);
+    BOOST_TEST_EQ(a(-1.1), 0);
+    BOOST_TEST_EQ(a(0.0), 2);
+    BOOST_TEST_EQ(a(0.9), 2);
+    BOOST_TEST_EQ(a(1.0), 3);
+    BOOST_TEST_EQ(a(10.), 4);
+    BOOST_TEST_EQ(a(-std::numeric_limits<double>::infinity()), -1);
+    BOOST_TEST_EQ(a(std::numeric_limits<double>::infinity()), 4);
+    BOOST_TEST_EQ(a(std::numeric_limits<double>::quiet_NaN()), 4);
+
+    A b("foo");
+    BOOST_TEST_NE(a, b);
+    BOOST_TEST_EQ(b.metadata(), "foo");
+    a = b;
+    BOOST_TEST_EQ(a, b);
+
+    std::ostringstream os;
+    os << a;
+    BOOST_TEST_EQ(os.str(),
+                  "static_regular(4, -2, 2, metadata=\"foo\", "
+                  "options=underflow_and_overflow)");
+  }
+
+  // fractional range and options
+  {
+    using A =
+        axis::static_regular<3, std::ratio<1, 2>, std::ratio<2>, axis::option_type::none>;
+    A a;
+    BOOST_TEST_EQ(axis::traits::extend(a), 3);
+    BOOST_TEST_EQ(a.value(0), 0.5);
+    BOOST_TEST_EQ(a.value(1), 1);
+    BOOST_TEST_EQ(a.value(3), 2);
+    BOOST_TEST_EQ(a(0.4), -1);
+    BOOST_TEST_EQ(a(1.2), 1);
+    BOOST_TEST_EQ(a(2), 3);
+  }
+
+  // agrees with regular axis away from bin edges, also for index_n
+  {
+    using A = axis::static_regular<100, std::ratio<0>, std::ratio<1>>;
+    const A a;
+    const auto b = axis::regular<>(100, 0, 1);
+    std::vector<double> x;
+    for (int i = -20; i < 1020; ++i) x.push_back(1e-3 * i + 1e-4);
+    x.push_back(std::numeric_limits<double>::quiet_NaN());
+    std::vector<int> out(x.size());
+    a.index_n(x.data(), out.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      BOOST_TEST_EQ(a(x[i]), b(x[i]));
+      BOOST_TEST_EQ(out[i], a(x[i]));
+    }
+  }
+
+  // multiplies by N / (stop - start), so values on a bin edge may end up in another bin
+  // than with the regular axis, which divides by the bin width
+  {
+    using A = axis::static_regular<100, std::ratio<-1>, std::ratio<1>>;
+    const A a;
+    const auto b = axis::regular<>(100, -1, 1);
+    BOOST_TEST_EQ(a(-0.54), 23);
+    BOOST_TEST_EQ(b(-0.54), 22);
+    BOOST_TEST_EQ(a.value(23), -0.54);
+  }
+
+  // histogram with static and dynamic axes
+  {
+    using A = axis::static_regular<2, std::ratio<0>, std::ratio<1>>;
+    auto h = make_histogram(A(), axis::regular<>(2, 0, 1));
+    h(0.2, 0.7);
+    h.fill(std::vector<double>{0.2, 0.7}, std::vector<double>{0.7, 0.2});
+    BOOST_TEST_EQ(h.at(0, 1), 2);
+    BOOST_TEST_EQ(h.at(1, 0), 1);
+
+    using V = axis::variant<A, axis::regular<>>;
+    auto h2 = make_histogram(std::vector<V>{A(), axis::regular<>(2, 0, 1)});
+    h2(0.2, 0.7);
+    BOOST_TEST_EQ(h2.at(0, 1), 1);
+    BOOST_TEST_EQ(h2.axis(0).size(), 2);
+
+    // axis cannot be reduced, only copied unchanged
+    BOOST_TEST_EQ(algorithm::reduce(h, algorithm::shrink(0, 0, 1)).rank(), 2);
+    BOOST_TEST_THROWS(algorithm::reduce(h, algorithm::shrink(0, 0, 0.5)),
+                      std::invalid_argument);
+  }
+
+  // iterators
+  {
+    test_axis_iterator(axis::static_regular<5, std::ratio<0>, std::ratio<1>>(), 0, 5);
+  }
+
+  return boost::report_errors();
+}
@@ -4,10 +4,13 @@
 // (See accompanying file LICENSE_1_0.txt
 // or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <algorithm>
 #include <boost/core/lightweight_test.hpp>
 #include <boost/histogram/axis/ostream_operators.hpp>
 #include <boost/histogram/axis/variable.hpp>
+#include <cmath>
 #include <limits>
+#include <vector>
 #include "utility_axis.hpp"
 
 using namespace boost::histogram;
@@ -50,6 +53,42 @@ int main() {
     BOOST_TEST_EQ(a(std::numeric_limits<double>::quiet_NaN()), 2);
   }
 
+  // axis::variable with many edges agrees with binary search
+  {
+    auto test = [](const std::vector<double>& edges) {
+      const double inf = std::numeric_limits<double>::infinity();
+      const double nan = std::numeric_limits<double>::quiet_NaN();
+      std::vector<double> x = {-inf, inf, nan};
+      for (auto&& e : edges) {
+        x.push_back(e);
+        x.push_back(std::nextafter(e, -inf));
+        x.push_back(std::nextafter(e, inf));
+      }
+      for (int i = 0; i < 1000; ++i)
+        x.push_back(edges.front() + (edges.back() - edges.front()) * (0.0013 * i - 0.1));
+
+      auto a = axis::variable<>(edges);
+      auto b = a;
+      auto c = std::move(b);
+      auto d = axis::variable<>({1, 2});
+      d = c;
+      for (auto&& xi : x) {
+        const int ref =
+            std::upper_bound(edges.begin(), edges.end(), xi) - edges.begin() - 1;
+        BOOST_TEST_EQ(a(xi), ref);
+        BOOST_TEST_EQ(d(xi), ref);
+      }
+    };
+
+    std::vector<double> uniform, log_spaced;
+    for (int i = 0; i <= 100; ++i) {
+      uniform.push_back(-1 + 0.02 * i);
+      log_spaced.push_back(std::pow(10, 0.1 * i - 5));
+    }
+    test(uniform);
+    test(log_spaced);
+  }
+
   // iterators
   { test_axis_iterator(axis::variable<>({1, 2, 3}, ""), 0, 2); }
 
@@ -0,0 +1,180 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/adaptive_storage.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/chunked_adaptive_storage.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace bh = boost::histogram;
+using adaptive_storage_type = bh::adaptive_storage<>;
+using chunked_storage_type =
+    bh::chunked_adaptive_storage<adaptive_storage_type::allocator_type, 4>;
+
+using bh::weight;
+
+template <typename T>
+char type_index() {
+  return adaptive_storage_type::type_index<T>();
+}
+
+int main() {
+  // empty and layout of chunks
+  {
+    chunked_storage_type a;
+    BOOST_TEST_EQ(a.size(), 0);
+    BOOST_TEST_EQ(a.chunks.size(), 0);
+    a.reset(10);
+    BOOST_TEST_EQ(a.size(), 10);
+    BOOST_TEST_EQ(a.chunks.size(), 3);
+    BOOST_TEST_EQ(a.chunks[0].size(), 4);
+    BOOST_TEST_EQ(a.chunks[1].size(), 4);
+    BOOST_TEST_EQ(a.chunks[2].size(), 2);
+    for (std::size_t i = 0; i < a.size(); ++i) BOOST_TEST_EQ(a[i], 0);
+    a.reset(4);
+    BOOST_TEST_EQ(a.chunks.size(), 1);
+  }
+
+  // fill and add
+  {
+    chunked_storage_type a;
+    a.reset(10);
+    a(0);
+    a(5);
+    a(5);
+    a(9);
+    a.add(3, 2);
+    a(9, weight(0.5));
+    BOOST_TEST_EQ(a[0], 1);
+    BOOST_TEST_EQ(a[1], 0);
+    BOOST_TEST_EQ(a[3], 2);
+    BOOST_TEST_EQ(a[5], 2);
+    BOOST_TEST_EQ(a[9], 1.5);
+  }
+
+  // hot bin only widens its own chunk
+  {
+    chunked_storage_type a;
+    a.reset(16);
+    for (std::size_t i = 0; i < 12; ++i) a(i);
+    for (unsigned k = 0; k < 70000; ++k) a(5);
+    BOOST_TEST_EQ(a[5], 70001);
+    BOOST_TEST_EQ(a[4], 1);
+    BOOST_TEST_EQ(a.chunks[0].buffer.type, type_index<uint8_t>());
+    BOOST_TEST_EQ(a.chunks[1].buffer.type, type_index<uint32_t>());
+    BOOST_TEST_EQ(a.chunks[2].buffer.type, type_index<uint8_t>());
+    BOOST_TEST_EQ(a.chunks[3].buffer.type, type_index<void>());
+    a(0, weight(0.5));
+    BOOST_TEST_EQ(a[0], 1.5);
+    BOOST_TEST_EQ(a.chunks[0].buffer.type, type_index<double>());
+    BOOST_TEST_EQ(a.chunks[1].buffer.type, type_index<uint32_t>());
+    BOOST_TEST_EQ(a.chunks[2].buffer.type, type_index<uint8_t>());
+    BOOST_TEST_EQ(a.chunks[3].buffer.type, type_index<void>());
+  }
+
+  // insert_zeros keeps counters integral, within the last chunk and across chunks
+  {
+    chunked_storage_type a;
+    a.reset(6);
+    for (std::size_t i = 0; i < a.size(); ++i) a(i);
+    a(5);
+    a.insert_zeros(5, 1);
+    BOOST_TEST_EQ(a.size(), 7);
+    BOOST_TEST_EQ(a.chunks.size(), 2);
+    a.insert_zeros(5, 3);
+    BOOST_TEST_EQ(a.size(), 10);
+    BOOST_TEST_EQ(a.chunks.size(), 3);
+    BOOST_TEST_EQ(a.chunks[2].size(), 2);
+    for (std::size_t i = 0; i < 5; ++i) BOOST_TEST_EQ(a[i], 1);
+    for (std::size_t i = 5; i < 9; ++i) BOOST_TEST_EQ(a[i], 0);
+    BOOST_TEST_EQ(a[9], 2);
+    BOOST_TEST_EQ(a.chunks[0].buffer.type, type_index<uint8_t>());
+    BOOST_TEST_EQ(a.chunks[1].buffer.type, type_index<uint8_t>());
+    BOOST_TEST_EQ(a.chunks[2].buffer.type, type_index<uint8_t>());
+    a.insert_zeros(10, 2);
+    BOOST_TEST_EQ(a.size(), 12);
+    BOOST_TEST_EQ(a.chunks.size(), 3);
+    BOOST_TEST_EQ(a[9], 2);
+    BOOST_TEST_EQ(a[11], 0);
+  }
+
+  // equal, copy, move
+  {
+    chunked_storage_type a, b;
+    a.reset(6);
+    b.reset(6);
+    BOOST_TEST(a == b);
+    a(4);
+    BOOST_TEST(!(a == b));
+    b = a;
+    BOOST_TEST(a == b);
+    auto c = std::move(b);
+    BOOST_TEST(a == c);
+    chunked_storage_type d;
+    d.reset(5);
+    BOOST_TEST(!(a == d));
+
+    auto e = bh::storage_adaptor<std::vector<int>>();
+    e.reset(6);
+    e(4);
+    BOOST_TEST(a == e);
+    e(4);
+    BOOST_TEST(!(a == e));
+  }
+
+  // add and scale
+  {
+    chunked_storage_type a, b;
+    a.reset(6);
+    b.reset(6);
+    a(1);
+    b(1);
+    b(5, weight(2));
+    a += b;
+    BOOST_TEST_EQ(a[1], 2);
+    BOOST_TEST_EQ(a[5], 2);
+    a += a;
+    BOOST_TEST_EQ(a[1], 4);
+    BOOST_TEST_EQ(a[5], 4);
+
+    auto c = bh::storage_adaptor<std::vector<int>>();
+    c.reset(6);
+    c(0);
+    a += c;
+    BOOST_TEST_EQ(a[0], 1);
+
+    a *= 0.5;
+    BOOST_TEST_EQ(a[0], 0.5);
+    BOOST_TEST_EQ(a[1], 2);
+    BOOST_TEST_EQ(a[5], 2);
+  }
+
+  // in histogram
+  {
+    const auto ax = bh::axis::integer<>(0, 10);
+    auto h = bh::make_histogram_with(chunked_storage_type(), ax);
+    auto h2 = bh::make_histogram_with(adaptive_storage_type(), ax);
+    for (int i = -1; i < 11; ++i) {
+      h(i);
+      h2(i);
+    }
+    h(3, weight(2));
+    h2(3, weight(2));
+    BOOST_TEST_EQ(h.at(-1), 1);
+    BOOST_TEST_EQ(h.at(3), 3);
+    BOOST_TEST_EQ(h.at(10), 1);
+    BOOST_TEST(h == h2);
+    h += h;
+    BOOST_TEST_EQ(h.at(3), 6);
+  }
+
+  return boost::report_errors();
+}
@@ -13,7 +13,10 @@
 #include <boost/histogram/axis/variable.hpp>
 #include <boost/histogram/detail/axes.hpp>
 #include <boost/histogram/detail/cat.hpp>
+#include <boost/histogram/detail/fast_math.hpp>
 #include <boost/histogram/detail/is_set.hpp>
+#include <cmath>
+#include <limits>
 #include <tuple>
 #include <vector>
 #include "utility_meta.hpp"
@@ -126,5 +129,24 @@ int main() {
     BOOST_TEST_NOT(detail::is_set(v.begin(), v.end()));
   }
 
+  // fast_log and fast_exp
+  {
+    const double tol = detail::fast_math_tolerance;
+    for (int i = -3000; i <= 3000; ++i) {
+      const double x = std::exp(0.2345 * i);
+      const double y = std::log(x);
+      BOOST_TEST_LE(std::abs(detail::fast_log(x) - y), tol * (1 + std::abs(y)));
+      const double z = 0.2345 * i * 0.1;
+      BOOST_TEST_LE(std::abs(detail::fast_exp(z) - std::exp(z)), tol * std::exp(z));
+    }
+    BOOST_TEST_EQ(detail::fast_log(1), 0);
+    BOOST_TEST_EQ(detail::fast_exp(0), 1);
+    const double inf = std::numeric_limits<double>::infinity();
+    for (double x : {0.0, -1.0, 1e-310, inf, -inf})
+      BOOST_TEST(std::isnan(detail::fast_log(x)));
+    for (double x : {-800.0, 800.0, inf, -inf})
+      BOOST_TEST(std::isnan(detail::fast_exp(x)));
+  }
+
   return boost::report_errors();
 }
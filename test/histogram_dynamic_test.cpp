@@ -15,6 +15,7 @@
 #include <limits>
 #include <numeric>
 #include <sstream>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -67,6 +68,28 @@ int main() {
     h1(1);
     BOOST_TEST_THROWS(h1.at(0, 0), std::invalid_argument);
     BOOST_TEST_THROWS(h1.at(std::make_tuple(0, 0)), std::invalid_argument);
+    const std::vector<int> x(2);
+    BOOST_TEST_THROWS(h1.fill(x, x), std::invalid_argument);
+  }
+
+  // bad bulk fill argument
+  {
+    auto h = make(dynamic_tag(), axis::integer<>(0, 3));
+    const std::vector<std::string> x(2);
+    BOOST_TEST_THROWS(h.fill(x), std::invalid_argument);
+  }
+
+  // bulk fill with different axis types in variant
+  {
+    auto h = make(dynamic_tag(), axis::integer<>(0, 3), axis::regular<>(2, 0, 1),
+                  axis::integer<>(-1, 1));
+    auto h2 = h;
+    const std::vector<double> x = {-1, 0, 1, 2, 3, 0.5};
+    const std::vector<double> y = {0.1, 0.6, -1, 2, 0.3, 0.7};
+    const std::vector<double> z = {-1, 0, 1, -2, 0, -1};
+    for (unsigned i = 0; i < x.size(); ++i) h(x[i], y[i], z[i]);
+    h2.fill(x, y, z);
+    BOOST_TEST_EQ(h2, h);
   }
 
   {
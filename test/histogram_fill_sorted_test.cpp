@@ -0,0 +1,119 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// small threshold, so that the two-phase bulk fill is used for small histograms
+#define BOOST_HISTOGRAM_SORTED_FILL_THRESHOLD 1000
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/ostream_operators.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <vector>
+
+using namespace boost::histogram;
+
+// counter which records the order in which counters are incremented
+struct recording_counter {
+  static std::vector<const recording_counter*> log;
+  int value = 0;
+  recording_counter& operator++() {
+    log.push_back(this);
+    ++value;
+    return *this;
+  }
+  recording_counter& operator+=(const recording_counter& o) {
+    value += o.value;
+    return *this;
+  }
+  bool operator==(const recording_counter& o) const { return value == o.value; }
+};
+
+std::vector<const recording_counter*> recording_counter::log;
+
+// fills h and returns how often the storage block of an increment is lower than that of
+// the previous one, which happens once per buffer of samples in a sorted fill
+template <typename H, typename X, typename Y>
+unsigned count_descents(H& h, const X& x, const Y& y) {
+  recording_counter::log.clear();
+  h.fill(x, y);
+  const auto& s = unsafe_access::storage(h);
+  unsigned bits = 0;
+  while (((s.size() - 1) >> bits) > 0) ++bits;
+  const unsigned shift = bits - detail::fill_n_sort_bits;
+  unsigned n = 0;
+  for (std::size_t i = 1; i < recording_counter::log.size(); ++i)
+    n += ((recording_counter::log[i] - &s[0]) >> shift) <
+         ((recording_counter::log[i - 1] - &s[0]) >> shift);
+  return n;
+}
+
+int main() {
+  using detail::fill_n_sort_size;
+
+  std::vector<int> x(2 * fill_n_sort_size + 11), y(x.size());
+  std::vector<double> w(x.size());
+  for (unsigned i = 0; i < x.size(); ++i) {
+    x[i] = (i * 7919) % 103 - 2;
+    y[i] = (i * 104729) % 101 - 1;
+    w[i] = 0.1 * (i % 7);
+  }
+
+  // counts, with and without growing axis
+  {
+    auto h = make_histogram(axis::integer<>(0, 100), axis::integer<>(0, 100));
+    BOOST_TEST_GE(h.size(), detail::fill_n_sort_threshold);
+    auto h2 = h;
+    for (unsigned i = 0; i < x.size(); ++i) h(x[i], y[i]);
+    h2.fill(x, y);
+    BOOST_TEST_EQ(h2, h);
+    BOOST_TEST_EQ(algorithm::sum(h2), x.size());
+
+    auto h3 = make_histogram(axis::regular<>(50, 0, 50, "", axis::option_type::growth),
+                             axis::integer<>(0, 100));
+    auto h4 = h3;
+    for (unsigned i = 0; i < x.size(); ++i) h3(x[i], y[i]);
+    h4.fill(x, y);
+    BOOST_TEST_EQ(h4, h3);
+  }
+
+  // sorted fill is used for axes which can grow, whether they grow or not
+  {
+    using S = storage_adaptor<std::vector<recording_counter>>;
+    using O = axis::option_type;
+    auto h = make_histogram_with(S(), axis::regular<>(100, 0, 100),
+                                 axis::regular<>(100, 0, 100));
+    BOOST_TEST_LE(count_descents(h, x, y), 2);
+    BOOST_TEST_EQ(recording_counter::log.size(), x.size());
+
+    auto h2 = make_histogram_with(S(), axis::regular<>(50, 0, 50, "", O::growth),
+                                  axis::integer<>(0, 100));
+    BOOST_TEST_LE(count_descents(h2, x, y), 2);
+    BOOST_TEST_GE(h2.axis(0).size(), 103);
+    BOOST_TEST_EQ(recording_counter::log.size(), x.size());
+  }
+
+  // weights are added in the original order within each bin
+  {
+    auto h = make_histogram_with(std::vector<accumulators::weighted_sum<>>(),
+                                 axis::integer<>(0, 100), axis::integer<>(0, 100));
+    auto h2 = h;
+    for (unsigned i = 0; i < x.size(); ++i) h(weight(w[i]), x[i], y[i]);
+    h2.fill(weight(w), x, y);
+    BOOST_TEST_EQ(h2, h);
+  }
+
+  // fill by index
+  {
+    auto h = make_histogram(axis::integer<>(0, 100), axis::integer<>(0, 100));
+    auto h2 = h;
+    for (unsigned i = 0; i < x.size(); ++i) h.fill_by_index(x[i], y[i]);
+    h2.fill_by_index(x, y);
+    BOOST_TEST_EQ(h2, h);
+  }
+
+  return boost::report_errors();
+}
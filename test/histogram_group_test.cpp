@@ -0,0 +1,129 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/histogram_group.hpp>
+#include <stdexcept>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+
+template <typename Tag>
+void run_tests() {
+  // enough values for several blocks, some outside of the axis range
+  std::vector<double> x;
+  std::vector<int> y;
+  std::vector<double> w;
+  for (int i = 0; i < 2000; ++i) {
+    x.push_back((i % 13) * 0.1 - 0.1);
+    y.push_back(i % 5 - 1);
+    w.push_back(0.5 * (i % 3));
+  }
+
+  // histograms with the same axes share all of them
+  {
+    auto h = make(Tag(), axis::regular<>(5, 0, 1), axis::integer<>(0, 3));
+    histogram_group<decltype(h)> g;
+    BOOST_TEST_EQ(g.add(h), 0);
+    BOOST_TEST_EQ(g.add(h, {0, 1}), 1);
+    BOOST_TEST_EQ(g.size(), 2);
+    BOOST_TEST_EQ(g.unique_axes(), 2);
+
+    g.fill(x, y);
+    g(0.3, 1);
+    h.fill(x, y);
+    h(0.3, 1);
+    BOOST_TEST(g[0] == h);
+    BOOST_TEST(g[1] == h);
+
+    g.fill(weight(w), x, y);
+    g(weight(2), 0.3, 1);
+    h.fill(weight(w), x, y);
+    h(weight(2), 0.3, 1);
+    BOOST_TEST(g[0] == h);
+    BOOST_TEST(g[1] == h);
+
+    g.reset();
+    BOOST_TEST_EQ(algorithm::sum(g[0]), 0);
+  }
+
+  // axes are shared only if they are equal and read the same value
+  {
+    auto h1 = make(Tag(), axis::integer<>(0, 3), axis::integer<>(0, 3));
+    auto h2 = make(Tag(), axis::integer<>(0, 3), axis::integer<>(0, 4));
+    auto h3 = h1;
+    histogram_group<decltype(h1)> g;
+    g.add(h1, {0, 1});
+    g.add(h2, {0, 1});
+    g.add(h3, {1, 0});
+    BOOST_TEST_EQ(g.unique_axes(), 3);
+
+    std::vector<int> z(y.rbegin(), y.rend());
+    g.fill(y, z);
+    h1.fill(y, z);
+    h2.fill(y, z);
+    h3.fill(z, y);
+    BOOST_TEST(g[0] == h1);
+    BOOST_TEST(g[1] == h2);
+    BOOST_TEST(g[2] == h3);
+  }
+
+  // bad arguments
+  {
+    auto h = make(Tag(), axis::regular<>(5, 0, 1), axis::integer<>(0, 3));
+    histogram_group<decltype(h)> g;
+    BOOST_TEST_THROWS(g.add(h, {0}), std::invalid_argument);
+    g.add(h, {0, 2});
+    BOOST_TEST_THROWS(g(0.1, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(g.fill(x, y), std::invalid_argument);
+    BOOST_TEST_THROWS(g.fill(x, y, std::vector<int>(3)), std::invalid_argument);
+
+    // axes which grow are not supported
+    auto h2 = make(Tag(), axis::regular<>(5, 0, 1, "", axis::option_type::growth),
+                   axis::integer<>(0, 3));
+    histogram_group<decltype(h2)> g2;
+    BOOST_TEST_THROWS(g2.add(h2), std::invalid_argument);
+    BOOST_TEST_EQ(g2.size(), 0);
+  }
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  // histograms with different rank, some axes used twice
+  {
+    using V = axis::variant<axis::regular<>, axis::integer<>>;
+    using axes_type = std::vector<V>;
+    const auto ax = axis::regular<>(4, 0, 1);
+    const auto ay = axis::integer<>(0, 3);
+    auto hx = make_histogram(axes_type{ax});
+    auto hyx = make_histogram(axes_type{ay, ax});
+    auto hxx = make_histogram(axes_type{ax, ax});
+    histogram_group<decltype(hx)> g;
+    g.add(hx, {1});
+    g.add(hyx);
+    g.add(hxx, {1, 1});
+    BOOST_TEST_EQ(g.unique_axes(), 2);
+
+    const std::vector<int> y = {0, 1, 2, 1};
+    const std::vector<double> x = {0.1, 0.5, 0.9, 2};
+    g.fill(y, x);
+    for (auto&& xi : x) hx(xi);
+    hyx.fill(y, x);
+    hxx.fill(x, x);
+    BOOST_TEST(g[0] == hx);
+    BOOST_TEST(g[1] == hyx);
+    BOOST_TEST(g[2] == hxx);
+    BOOST_TEST_EQ(g[2].at(0, 0), 1);
+    BOOST_TEST_EQ(g[2].at(0, 1), 0);
+  }
+
+  return boost::report_errors();
+}
@@ -12,6 +12,7 @@
 #include <boost/histogram/serialization.hpp>
 #include <sstream>
 #include <string>
+#include <vector>
 #include "utility_histogram.hpp"
 
 using namespace boost::histogram;
@@ -44,6 +45,82 @@ void run_tests() {
     }
     BOOST_TEST_EQ(a, b);
   }
+
+  // axes with search index
+  {
+    std::vector<int> v(100);
+    std::vector<double> e(101);
+    for (unsigned i = 0; i < v.size(); ++i) v[i] = 3 * i;
+    for (unsigned i = 0; i < e.size(); ++i) e[i] = i;
+    auto a = make(Tag(), axis::category<>(v), axis::variable<>(e));
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << a;
+      buf = os.str();
+    }
+    auto b = decltype(a)();
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST_EQ(a, b);
+    b(30, 10.5);
+    b(31, 99.5);
+    BOOST_TEST_EQ(b.at(10, 10), 1);
+    BOOST_TEST_EQ(b.at(100, 99), 1);
+  }
+
+  // circular axis bins edge values like the original after saving and loading
+  {
+    auto a = make(Tag(), axis::circular<>(5, 0, 0.1 * 51));
+    const auto ref = a;
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << a;
+      buf = os.str();
+    }
+    auto b = decltype(a)();
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST_EQ(a, b);
+    for (int i = 0; i < 5; ++i) {
+      const double x = ref.axis().value(i);
+      BOOST_TEST_EQ(a.axis()(x), ref.axis()(x));
+      BOOST_TEST_EQ(b.axis()(x), ref.axis()(x));
+    }
+  }
+
+  // axis with derived state
+  {
+    auto a = make(Tag(), axis::log_linear<>(4, 1, 16));
+    a(3);
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << a;
+      buf = os.str();
+    }
+    auto b = decltype(a)();
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST_EQ(a, b);
+    b(0.5);
+    b(3.2);
+    BOOST_TEST_EQ(b.at(-1), 1);
+    BOOST_TEST_EQ(b.at(6), 2);
+  }
 }
 
 int main() {
@@ -12,12 +12,15 @@
 #include <boost/histogram/adaptive_storage.hpp>
 #include <boost/histogram/algorithm/sum.hpp>
 #include <boost/histogram/axis/variant.hpp>
+#include <boost/histogram/chunked_adaptive_storage.hpp>
 #include <boost/histogram/histogram.hpp>
 #include <boost/histogram/literals.hpp>
 #include <boost/histogram/ostream_operators.hpp>
 #include <boost/histogram/sample.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/unsafe_access.hpp>
 #include <boost/histogram/weight.hpp>
+#include <cmath>
 #include <sstream>
 #include <stdexcept>
 #include <tuple>
@@ -40,6 +43,33 @@ void pass_histogram(boost::histogram::histogram<A, S>& h) {
   BOOST_TEST_EQ(h.axis(0_c), axis::integer<>(0, 3));
 }
 
+// counter which throws when a negative weight is added
+struct throwing_counter {
+  double value = 0;
+  throwing_counter& operator++() {
+    ++value;
+    return *this;
+  }
+  throwing_counter& operator+=(double w) {
+    if (w < 0) throw std::invalid_argument("negative weight");
+    value += w;
+    return *this;
+  }
+  throwing_counter& operator+=(const throwing_counter& o) { return operator+=(o.value); }
+};
+
+// regular axis which counts the calls of update
+struct update_counting_axis : axis::regular<> {
+  using axis::regular<>::regular;
+  std::pair<int, int> update(double x) {
+    ++updates;
+    return axis::regular<>::update(x);
+  }
+  static unsigned updates;
+};
+
+unsigned update_counting_axis::updates = 0;
+
 template <typename Tag>
 void run_tests() {
   // init_1
@@ -127,6 +157,10 @@ void run_tests() {
                         storage_adaptor<std::vector<unsigned>>>();
     h3 = h;
     BOOST_TEST_EQ(h, h3);
+    // bin layout is updated
+    h3(0, 1);
+    BOOST_TEST_EQ(h3.at(0, 1), 1);
+    BOOST_TEST_EQ(h3.index(0, 1), 3);
   }
 
   // move
@@ -430,6 +464,267 @@ void run_tests() {
     }
   }
 
+  // bulk fill 1D
+  {
+    auto h = make(Tag(), axis::regular<>(2, 0, 1));
+    auto h2 = h;
+    const std::vector<double> x = {-1, 0.1, 0.6, 0.7, 2, -0.5, 0.3};
+    for (auto&& xi : x) h(xi);
+    h2.fill(x);
+    BOOST_TEST_EQ(h2, h);
+    h2.fill(std::vector<double>());
+    BOOST_TEST_EQ(h2, h);
+    const double y[3] = {0.1, 0.2, 0.8};
+    h2.fill(y);
+    BOOST_TEST_EQ(h2.at(0), 4);
+    BOOST_TEST_EQ(h2.at(1), 3);
+  }
+
+  // bulk fill 2D with weights, larger than one block
+  {
+    auto h = make_s(Tag(), std::vector<accumulators::weighted_sum<>>(),
+                    axis::integer<>(0, 3), axis::regular<>(4, 0, 1));
+    auto h2 = h;
+    std::vector<int> x(3 * boost::histogram::detail::fill_n_block_size + 7);
+    std::vector<double> y(x.size()), w(x.size());
+    for (unsigned i = 0; i < x.size(); ++i) {
+      x[i] = i % 5 - 1;
+      y[i] = 0.01 * (i % 111) - 0.05;
+      w[i] = 0.5 * (i % 3);
+    }
+    for (unsigned i = 0; i < x.size(); ++i) h(weight(w[i]), x[i], y[i]);
+    h2.fill(weight(w), x, y);
+    BOOST_TEST_EQ(h2, h);
+  }
+
+  // index and fill_by_index
+  {
+    auto h = make(Tag(), axis::integer<>(0, 3),
+                  axis::integer<>(0, 2, "", axis::option_type::none));
+    auto h2 = h;
+    const std::vector<int> x = {-1, 0, 1, 2, 3, 4, 1, 1};
+    const std::vector<int> y = {0, 1, 0, -1, 1, 0, 2, 1};
+    for (unsigned i = 0; i < x.size(); ++i) h(x[i], y[i]);
+
+    // single
+    for (unsigned i = 0; i < x.size(); ++i) {
+      const auto j = h.index(x[i], y[i]);
+      BOOST_TEST_EQ(j < h.size(), y[i] >= 0 && y[i] < 2);
+      h2.fill_by_linear_index(j);
+    }
+    BOOST_TEST_EQ(h2, h);
+    h2.reset();
+    std::vector<int> xi(x.size());
+    for (unsigned i = 0; i < x.size(); ++i) xi[i] = x[i] < 0 ? -1 : std::min(x[i], 3);
+    for (unsigned i = 0; i < x.size(); ++i) h2.fill_by_index(xi[i], y[i]);
+    BOOST_TEST_EQ(h2, h);
+    h2.fill_by_index(5, 0);
+    h2.fill_by_index(0, -1);
+    BOOST_TEST_EQ(h2, h);
+
+    // batch
+    std::vector<std::size_t> j(x.size());
+    h.index_n(j.data(), x, y);
+    for (unsigned i = 0; i < x.size(); ++i) {
+      const auto k = h.index(x[i], y[i]);
+      BOOST_TEST_EQ(j[i] < h.size(), k < h.size());
+      if (k < h.size()) BOOST_TEST_EQ(j[i], k);
+    }
+    h2.reset();
+    h2.fill_by_linear_index(j);
+    BOOST_TEST_EQ(h2, h);
+    h2.reset();
+    h2.fill_by_index(xi, y);
+    BOOST_TEST_EQ(h2, h);
+
+    // batch with weights
+    const std::vector<double> w(x.size(), 2);
+    h2.reset();
+    h2.fill_by_linear_index(weight(w), j);
+    BOOST_TEST_EQ(h2.at(1, 0), 2 * h.at(1, 0));
+    BOOST_TEST_EQ(algorithm::sum(h2), 2 * algorithm::sum(h));
+    h2.reset();
+    h2.fill_by_index(weight(w), xi, y);
+    BOOST_TEST_EQ(algorithm::sum(h2), 2 * algorithm::sum(h));
+  }
+
+  // growing axis
+  {
+    using O = axis::option_type;
+    auto h = make_s(Tag(), std::vector<accumulators::weighted_sum<>>(),
+                    axis::regular<>(2, 0, 1, "", O::underflow_and_overflow | O::growth),
+                    axis::integer<>(0, 2));
+    h(0.1, 0);
+    h(weight(2), 0.6, 1);
+    h(1.2, 1); // range is now [0, 2)
+    BOOST_TEST_EQ(h.axis(0).size(), 4);
+    h(-0.1, 0); // range is now [-2, 2)
+    BOOST_TEST_EQ(h.axis(0).size(), 8);
+    h(std::numeric_limits<double>::quiet_NaN(), 1);
+    BOOST_TEST_EQ(h.axis(0).size(), 8);
+    BOOST_TEST_EQ(h.at(3, 0).value(), 1);
+    BOOST_TEST_EQ(h.at(4, 0).value(), 1);
+    BOOST_TEST_EQ(h.at(5, 1).value(), 2);
+    BOOST_TEST_EQ(h.at(6, 1).value(), 1);
+    BOOST_TEST_EQ(h.at(8, 1).value(), 1);
+    BOOST_TEST_EQ(algorithm::sum(h).value(), 6);
+
+    // bulk fill gives same result as single fills, also across blocks
+    auto h1 = make(Tag(), axis::regular<>(2, 0, 1, "", O::growth), axis::integer<>(0, 3));
+    auto h2 = h1;
+    std::vector<double> x(3 * boost::histogram::detail::fill_n_block_size);
+    std::vector<int> y(x.size());
+    for (unsigned i = 0; i < x.size(); ++i) {
+      x[i] = 0.1 * i * (i % 2 ? 1 : -1);
+      y[i] = i % 3;
+    }
+    for (unsigned i = 0; i < x.size(); ++i) h1(x[i], y[i]);
+    h2.fill(x, y);
+    BOOST_TEST_EQ(h2, h1);
+    BOOST_TEST_EQ(algorithm::sum(h2), x.size());
+    BOOST_TEST_EQ(h2.axis(0).value(0), h1.axis(0).value(0));
+    for (int i = 0; i < static_cast<int>(h1.axis(0).size()); ++i)
+      BOOST_TEST_EQ(h2.at(i, 2), h1.at(i, 2));
+    BOOST_TEST_EQ(h2.index(x[1], y[1]), h1.index(x[1], y[1]));
+  }
+
+  // value just below a lower edge added by growth is binned like operator() on the grown
+  // axis, so single and bulk fill agree
+  {
+    using O = axis::option_type;
+    const double x = std::nextafter(-0.1, -1.0); // just below edge -0.1
+    auto h1 = make(Tag(), axis::regular<>(1, 0.1, 0.2, "", O::growth));
+    auto h2 = h1;
+    h1(x);
+    h2.fill(std::vector<double>(1, x));
+    BOOST_TEST_EQ(h2, h1);
+    BOOST_TEST_EQ(algorithm::sum(h1), 1);
+    BOOST_TEST_EQ(h1.at(h1.axis()(x)), 1);
+  }
+
+  // growing axis is only updated for values outside of its bins
+  {
+    using O = axis::option_type;
+    auto h = make(Tag(), update_counting_axis(2, 0, 1, "", O::growth),
+                  axis::integer<>(0, 2));
+    update_counting_axis::updates = 0;
+    h(0.2, 0);
+    h(0.7, 1);
+    BOOST_TEST_EQ(update_counting_axis::updates, 0);
+    h(1.2, 1);
+    BOOST_TEST_EQ(update_counting_axis::updates, 1);
+    BOOST_TEST_EQ(h.axis(0).size(), 4);
+    BOOST_TEST_EQ(h.at(2, 1), 1);
+  }
+
+  // bin layout is updated after growth, even if the bulk fill throws afterwards
+  {
+    using O = axis::option_type;
+    auto h = make_s(Tag(), std::vector<throwing_counter>(),
+                    axis::regular<>(2, 0, 1, "", O::growth), axis::integer<>(0, 2));
+    const std::vector<double> x = {0.5, 2.5}, w = {1, -1};
+    const std::vector<int> y = {1, 1};
+    BOOST_TEST_THROWS(h.fill(weight(w), x, y), std::invalid_argument);
+    BOOST_TEST_EQ(h.axis(0).size(), 6);
+    h(2.5, 1);
+    BOOST_TEST_EQ(h.at(1, 1).value, 1);
+    BOOST_TEST_EQ(h.at(5, 1).value, 1);
+  }
+
+  // growing category axis, appending to vector-like storage and remapping others
+  {
+    using O = axis::option_type;
+    auto h1 = make_s(Tag(), std::vector<int>(), axis::integer<>(0, 2),
+                     axis::category<>({1}, "", O::overflow | O::growth));
+    auto h2 = make(Tag(), axis::integer<>(0, 2),
+                   axis::category<>({1}, "", O::overflow | O::growth));
+    auto h3 = make_s(Tag(), std::vector<int>(),
+                     axis::category<>({1}, "", O::overflow | O::growth),
+                     axis::integer<>(0, 2));
+    std::vector<int> x(100), y(100);
+    for (unsigned i = 0; i < x.size(); ++i) {
+      x[i] = i % 3;
+      y[i] = 5 * (i % 7) - 4;
+    }
+    for (unsigned i = 0; i < x.size(); ++i) {
+      h1(x[i], y[i]);
+      h2(x[i], y[i]);
+      h3(y[i], x[i]);
+    }
+    BOOST_TEST_EQ(h1.axis(1).size(), 7);
+    BOOST_TEST_EQ(h3.axis(0).size(), 7);
+    for (int i = -1; i < 3; ++i)
+      for (int j = 0; j < 8; ++j) {
+        BOOST_TEST_EQ(h1.at(i, j), h2.at(i, j));
+        BOOST_TEST_EQ(h1.at(i, j), h3.at(j, i));
+      }
+    BOOST_TEST_EQ(h1.at(2, 0), 5);
+    BOOST_TEST_EQ(h1.at(0, 1), 5);
+    BOOST_TEST_EQ(algorithm::sum(h1), x.size());
+
+    auto h4 = make_s(Tag(), std::vector<int>(), axis::integer<>(0, 2),
+                     axis::category<>({1}, "", O::overflow | O::growth));
+    h4.fill(x, y);
+    BOOST_TEST_EQ(h4, h1);
+  }
+
+  // growth keeps the counter type of adaptive storages
+  {
+    using O = axis::option_type;
+    using S = adaptive_storage<>;
+    using C = chunked_adaptive_storage<boost::container::new_allocator<void>, 4>;
+    auto h1 = make_s(Tag(), S(), axis::category<>({1}, "", O::growth),
+                     axis::integer<>(0, 2));
+    h1(1, 0);
+    h1(2, 1);
+    BOOST_TEST_EQ(h1.axis(0).size(), 2);
+    BOOST_TEST_EQ(h1.at(0, 0), 1);
+    BOOST_TEST_EQ(h1.at(1, 1), 1);
+    BOOST_TEST_EQ(unsafe_access::storage(h1).buffer.type, S::type_index<uint8_t>());
+
+    auto h2 = make_s(Tag(), S(), axis::regular<>(2, 0, 1, "", O::growth));
+    for (int i = 0; i < 300; ++i) h2(0.5);
+    h2(5.5);
+    BOOST_TEST_EQ(h2.axis().size(), 12);
+    BOOST_TEST_EQ(h2.at(1), 300);
+    BOOST_TEST_EQ(h2.at(11), 1);
+    BOOST_TEST_EQ(unsafe_access::storage(h2).buffer.type, S::type_index<uint16_t>());
+
+    auto h3 = make_s(Tag(), C(), axis::regular<>(2, 0, 1, "", O::growth),
+                     axis::integer<>(0, 2));
+    h3(0.5, 1);
+    h3(-1.5, 1);
+    BOOST_TEST_EQ(h3.axis(0).size(), 5);
+    BOOST_TEST_EQ(h3.at(4, 1), 1);
+    BOOST_TEST_EQ(h3.at(0, 1), 1);
+    BOOST_TEST_EQ(algorithm::sum(h3), 2);
+    for (auto&& c : unsafe_access::storage(h3).chunks)
+      BOOST_TEST(c.buffer.type == 0 || c.buffer.type == S::type_index<uint8_t>());
+  }
+
+  // new categories of the last axis are appended to adaptive storage with spare room
+  {
+    using O = axis::option_type;
+    using S = adaptive_storage<>;
+    auto h = make(Tag(), axis::integer<>(0, 2), axis::category<>({0}, "", O::growth));
+    for (int i = 0; i < 100; ++i) h(i % 2, i);
+    BOOST_TEST_EQ(h.axis(1).size(), 100);
+    for (int i = 0; i < 100; ++i) BOOST_TEST_EQ(h.at(i % 2, i), 1);
+    BOOST_TEST_EQ(algorithm::sum(h), 100);
+    const auto& s = unsafe_access::storage(h);
+    BOOST_TEST_EQ(s.buffer.type, S::type_index<uint8_t>());
+    BOOST_TEST_GT(s.buffer.capacity, s.size());
+  }
+
+  // bad bulk fill
+  {
+    auto h = make(Tag(), axis::integer<>(0, 2), axis::integer<>(0, 3));
+    const std::vector<int> x(3), y(4);
+    BOOST_TEST_THROWS(h.fill(x, y), std::invalid_argument);
+    BOOST_TEST_THROWS(h.fill(weight(y), x, x), std::invalid_argument);
+    BOOST_TEST_EQ(algorithm::sum(h), 0);
+  }
+
   // add_1
   {
     auto a = make(Tag(), axis::integer<>(0, 2));
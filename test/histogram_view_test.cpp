@@ -0,0 +1,117 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/reduce.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/ostream_operators.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/histogram_view.hpp>
+#include <boost/histogram/ostream_operators.hpp>
+#include <stdexcept>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+using namespace boost::histogram::algorithm;
+
+template <typename Tag>
+void run_tests() {
+  auto h = make(Tag(), axis::regular<>(4, 0, 4), axis::integer<>(0, 3),
+                axis::integer<>(0, 2, "", axis::option_type::none));
+  for (int i = 0; i < 100; ++i) h(i % 6 - 1, i % 5 - 1, i % 2);
+
+  // no options, view of all inner bins
+  {
+    auto v = make_histogram_view(h);
+    BOOST_TEST_EQ(v.rank(), 3);
+    BOOST_TEST_EQ(v.size(), 24);
+    BOOST_TEST_EQ(v.at(1, 2, 1), h.at(1, 2, 1));
+    BOOST_TEST_THROWS(v.at(-1, 0, 0), std::out_of_range);
+    BOOST_TEST_THROWS(v.at(0, 0), std::invalid_argument);
+  }
+
+  // shrink, indices start at zero like in the reduced histogram
+  {
+    auto v = make_histogram_view(h, shrink(0, 1, 3));
+    auto hr = reduce(h, shrink(0, 1, 3));
+    BOOST_TEST_EQ(v.rank(), 3);
+    BOOST_TEST_EQ(v.size(0), 2);
+    BOOST_TEST_EQ(v.size(), 12);
+    for (int i = 0; i < 2; ++i)
+      for (int j = 0; j < 3; ++j)
+        for (int k = 0; k < 2; ++k) BOOST_TEST_EQ(v.at(i, j, k), hr.at(i, j, k));
+    BOOST_TEST_THROWS(v.at(2, 0, 0), std::out_of_range);
+  }
+
+  // slice removes axis
+  {
+    auto v = make_histogram_view(h, slice(1, 2), shrink(0, 0, 2));
+    BOOST_TEST_EQ(v.rank(), 2);
+    BOOST_TEST_EQ(v.size(), 4);
+    for (int i = 0; i < 2; ++i)
+      for (int k = 0; k < 2; ++k) BOOST_TEST_EQ(v.at(i, k), h.at(i, 2, k));
+
+    // flow bins can be selected
+    auto v2 = make_histogram_view(h, slice(0, -1), slice(1, 3));
+    BOOST_TEST_EQ(v2.rank(), 1);
+    BOOST_TEST_EQ(v2.at(1), h.at(-1, 3, 1));
+  }
+
+  // iteration
+  {
+    auto v = make_histogram_view(h, shrink(0, 1, 3), slice(2, 1));
+    std::vector<double> x;
+    for (auto it = v.begin(); it != v.end(); ++it) {
+      BOOST_TEST_EQ(*it, v.at(it.idx(0), it.idx(1)));
+      BOOST_TEST_EQ(*it, h.at(it.idx(0) + 1, it.idx(1), 1));
+      x.push_back(*it);
+    }
+    BOOST_TEST_EQ(x.size(), v.size());
+    BOOST_TEST_EQ(v.end() - v.begin(), 6);
+    BOOST_TEST_EQ(v.begin()[4], x[4]);
+  }
+
+  // bad options
+  {
+    BOOST_TEST_THROWS(make_histogram_view(h, slice(0, 1), shrink(0, 1, 2)),
+                      std::invalid_argument);
+    BOOST_TEST_THROWS(make_histogram_view(h, rebin(0, 2)), std::invalid_argument);
+    BOOST_TEST_THROWS(make_histogram_view(h, slice(3, 0)), std::invalid_argument);
+    BOOST_TEST_THROWS(make_histogram_view(h, slice(2, -1)), std::out_of_range);
+    BOOST_TEST_THROWS(make_histogram_view(h, slice(2, 2)), std::out_of_range);
+    BOOST_TEST_THROWS(make_histogram_view(h, slice(1, 4)), std::out_of_range);
+  }
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  // materialize
+  {
+    auto h = make(dynamic_tag(), axis::regular<>(4, 0, 4), axis::integer<>(0, 3),
+                  axis::integer<>(0, 2, "", axis::option_type::none));
+    for (int i = 0; i < 100; ++i) h(i % 6 - 1, i % 5 - 1, i % 2);
+
+    auto v = make_histogram_view(h, shrink(0, 1, 3));
+    BOOST_TEST(v.materialize() == reduce(h, shrink(0, 1, 3)));
+    BOOST_TEST(make_histogram_view(h).materialize() == h);
+
+    auto h2 = make_histogram_view(h, slice(1, -1), shrink(0, 1, 3)).materialize();
+    BOOST_TEST_EQ(h2.rank(), 2);
+    BOOST_TEST_EQ(h2.axis(0), axis::regular<>(2, 1, 3));
+    BOOST_TEST_EQ(h2.axis(1), h.axis(2));
+    for (int k = 0; k < 2; ++k) {
+      BOOST_TEST_EQ(h2.at(-1, k), h.at(-1, -1, k) + h.at(0, -1, k));
+      BOOST_TEST_EQ(h2.at(0, k), h.at(1, -1, k));
+      BOOST_TEST_EQ(h2.at(1, k), h.at(2, -1, k));
+      BOOST_TEST_EQ(h2.at(2, k), h.at(3, -1, k) + h.at(4, -1, k));
+    }
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,115 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <boost/histogram/sharded_storage.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace bh = boost::histogram;
+using sharded_storage_type = bh::sharded_storage<>;
+
+int main() {
+  // empty state
+  {
+    sharded_storage_type a(3);
+    BOOST_TEST_EQ(a.shards(), 3);
+    BOOST_TEST_EQ(a.size(), 0);
+    a.reset(5);
+    BOOST_TEST_EQ(a.size(), 5);
+    for (std::size_t i = 0; i < a.size(); ++i) BOOST_TEST_EQ(a[i], 0);
+
+    sharded_storage_type b;
+    BOOST_TEST_GE(b.shards(), 1);
+  }
+
+  // increase, add, batch increase
+  {
+    sharded_storage_type a(2);
+    a.reset(3);
+    a(0);
+    a(2);
+    a(2);
+    a.add(1, 5);
+    const std::size_t idx[] = {0, 0, 1};
+    a.increment_n(idx, 3);
+    BOOST_TEST_EQ(a[0], 3);
+    BOOST_TEST_EQ(a[1], 6);
+    BOOST_TEST_EQ(a[2], 2);
+  }
+
+  // equal, copy, move
+  {
+    sharded_storage_type a(2), b(4);
+    a.reset(3);
+    b.reset(3);
+    BOOST_TEST(a == b);
+    a(1);
+    BOOST_TEST(!(a == b));
+    b = a;
+    BOOST_TEST(a == b);
+    BOOST_TEST_EQ(b.shards(), 2);
+    auto c = a;
+    BOOST_TEST(a == c);
+    auto d = std::move(c);
+    BOOST_TEST(a == d);
+    c = std::move(d);
+    BOOST_TEST(a == c);
+
+    auto e = bh::storage_adaptor<std::vector<int>>();
+    e.reset(3);
+    BOOST_TEST(!(a == e));
+    e(1);
+    BOOST_TEST(a == e);
+  }
+
+  // add storages
+  {
+    sharded_storage_type a(2), b(3);
+    a.reset(2);
+    b.reset(2);
+    a(0);
+    b(0);
+    b(1);
+    a += b;
+    BOOST_TEST_EQ(a[0], 2);
+    BOOST_TEST_EQ(a[1], 1);
+    a += a;
+    BOOST_TEST_EQ(a[0], 4);
+    BOOST_TEST_EQ(a[1], 2);
+
+    auto c = bh::storage_adaptor<std::vector<int>>();
+    c.reset(2);
+    c(1);
+    a += c;
+    BOOST_TEST_EQ(a[1], 3);
+  }
+
+  // concurrent fill, also with fewer shards than threads
+  for (unsigned nshards : {1, 3, 8}) {
+    auto h = bh::make_histogram_with(sharded_storage_type(nshards),
+                                     bh::axis::integer<>(0, 4));
+    std::vector<int> x(1000);
+    for (unsigned i = 0; i < x.size(); ++i) x[i] = i % 5;
+    auto fill = [&h, &x] {
+      for (unsigned k = 0; k < 10; ++k) {
+        for (auto xi : x) h(xi);
+        h.fill(x);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned k = 0; k < 6; ++k) threads.emplace_back(fill);
+    for (auto&& t : threads) t.join();
+    for (int i = -1; i < 5; ++i) BOOST_TEST_EQ(h.at(i), i == -1 ? 0 : 6 * 10 * 2 * 200);
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,160 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <boost/histogram/axis/category.hpp>
+#include <boost/histogram/axis/circular.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/variable.hpp>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace boost::histogram;
+
+// sink which prevents the compiler from optimizing away the computation
+volatile int sink;
+
+// best time out of several repetitions for n calls of the axis
+template <typename Axis, typename T>
+double measure(const Axis& a, const std::vector<T>& x) {
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 10; ++k) {
+    auto t = clock();
+    int sum = 0;
+    for (auto&& xi : x) sum += a(xi);
+    t = clock() - t;
+    sink = sum;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+  return best;
+}
+
+// same as measure, but computes the indices with index_n in blocks
+template <typename Axis, typename T>
+double measure_n(const Axis& a, const std::vector<T>& x) {
+  auto best = std::numeric_limits<double>::max();
+  std::vector<int> out(x.size());
+  for (unsigned k = 0; k < 10; ++k) {
+    auto t = clock();
+    int sum = 0;
+    for (std::size_t i = 0; i < x.size(); i += 1024) {
+      const auto m = std::min(x.size() - i, std::size_t(1024));
+      a.index_n(x.data() + i, out.data() + i, m);
+      for (std::size_t j = i; j < i + m; ++j) sum += out[j];
+    }
+    t = clock() - t;
+    sink = sum;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+  return best;
+}
+
+// values drawn uniformly from categories, 10 % of them are not in the axis
+template <typename T, typename F>
+double compare_category(unsigned n, unsigned ncat, F make_value) {
+  std::vector<T> cat;
+  for (unsigned i = 0; i < ncat; ++i) cat.push_back(make_value(i));
+  std::default_random_engine gen(1);
+  std::uniform_int_distribution<unsigned> d(0, ncat + ncat / 10);
+  std::vector<T> x;
+  for (unsigned i = 0; i < n; ++i) x.push_back(make_value(d(gen)));
+  return measure(axis::category<T>(cat), x);
+}
+
+// n + 1 edges, evenly spaced or spaced on a log scale, values uniform over range
+double compare_variable(unsigned n, unsigned nbins, bool log_spaced) {
+  std::vector<double> edges;
+  for (unsigned i = 0; i <= nbins; ++i)
+    edges.push_back(log_spaced ? std::pow(10.0, 6.0 * i / nbins) : 1.0 * i / nbins);
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> d(edges.front(), edges.back());
+  std::vector<double> x;
+  for (unsigned i = 0; i < n; ++i) x.push_back(d(gen));
+  return measure(axis::variable<>(edges), x);
+}
+
+// values log-uniform over the range of a transformed regular axis
+template <typename Transform>
+void compare_regular(const char* name, unsigned n, Transform t) {
+  const auto a = axis::regular<Transform>(t, 100, 1, 1e6);
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> d(-0.5, 6.5);
+  std::vector<double> x;
+  for (unsigned i = 0; i < n; ++i) x.push_back(std::pow(10.0, d(gen)));
+  printf("%s %.3f\n", name, measure(a, x));
+  printf("%s_n %.3f\n", name, measure_n(a, x));
+}
+
+// same values as compare_regular, 16 bins per factor of two
+void compare_log_linear(unsigned n) {
+  const auto a = axis::log_linear<>(16, 1, 1e6);
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> d(-0.5, 6.5);
+  std::vector<double> x;
+  for (unsigned i = 0; i < n; ++i) x.push_back(std::pow(10.0, d(gen)));
+  printf("log_linear %.3f\n", measure(a, x));
+  printf("log_linear_n %.3f\n", measure_n(a, x));
+}
+
+// status codes, 10 % of them outside of the axis range
+void compare_integer(unsigned n) {
+  const auto a = axis::integer<int>(100, 600);
+  std::default_random_engine gen(1);
+  std::uniform_int_distribution<> d(50, 650);
+  std::vector<int> x;
+  for (unsigned i = 0; i < n; ++i) x.push_back(d(gen));
+  printf("int %.3f\n", measure(a, x));
+  printf("int_n %.3f\n", measure_n(a, x));
+}
+
+// phase angles, which wrap around several times
+void compare_circular(unsigned n) {
+  const auto a = axis::circular<>(36, 0);
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> d(-20, 20);
+  std::vector<double> x;
+  for (unsigned i = 0; i < n; ++i) x.push_back(d(gen));
+  printf("circular %.3f\n", measure(a, x));
+  printf("circular_n %.3f\n", measure_n(a, x));
+}
+
+int main() {
+  const unsigned nfill = 1000000;
+
+  auto make_int = [](unsigned i) { return static_cast<int>(7 * i); };
+  auto make_string = [](unsigned i) { return "id-" + std::to_string(i); };
+
+  printf("category\n");
+  for (unsigned ncat : {10, 1000, 100000}) {
+    printf("int_%u %.3f\n", ncat, compare_category<int>(nfill, ncat, make_int));
+    printf("string_%u %.3f\n", ncat,
+           compare_category<std::string>(nfill, ncat, make_string));
+  }
+
+  printf("regular\n");
+  compare_regular("log", nfill, axis::transform::log<>());
+  compare_regular("pow", nfill, axis::transform::pow<>(0.3));
+  compare_log_linear(nfill);
+
+  printf("integer\n");
+  compare_integer(nfill);
+
+  printf("circular\n");
+  compare_circular(nfill);
+
+  printf("variable\n");
+  for (unsigned nbins : {10, 1000, 100000}) {
+    printf("uniform_%u %.3f\n", nbins, compare_variable(nfill, nbins, false));
+    printf("log_%u %.3f\n", nbins, compare_variable(nfill, nbins, true));
+  }
+}
@@ -12,6 +12,8 @@
 #include <limits>
 #include <memory>
 #include <random>
+#include <ratio>
+#include <vector>
 #include "utility_histogram.hpp"
 
 using namespace boost::histogram;
@@ -82,6 +84,41 @@ double compare_2d(unsigned n, int distrib) {
   return best;
 }
 
+// same binning as axis::regular<>(100, 0, 1), but configured at compile-time
+using static_axis = axis::static_regular<100, std::ratio<0>, std::ratio<1>>;
+
+template <typename Storage>
+double compare_1d_static(unsigned n, int distrib) {
+  auto r = random_array(n, distrib);
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 20; ++k) {
+    auto h = make_s(static_tag(), Storage(), static_axis());
+    auto t = clock();
+    for (unsigned i = 0; i < n; ++i) h(r[i]);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
+template <typename Storage>
+double compare_2d_static(unsigned n, int distrib) {
+  auto r = random_array(n, distrib);
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 20; ++k) {
+    auto h = make_s(static_tag(), Storage(), static_axis(), static_axis());
+    auto t = clock();
+    for (unsigned i = 0; i < n / 2; ++i) h(r[2 * i], r[2 * i + 1]);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
 template <typename Tag, typename Storage>
 double compare_3d(unsigned n, int distrib) {
   auto r = random_array(n, distrib);
@@ -121,6 +158,106 @@ double compare_6d(unsigned n, int distrib) {
   return best;
 }
 
+// split random array into one column per axis, as required by histogram::fill
+std::vector<std::vector<double>> random_columns(unsigned n, unsigned dim, int type) {
+  auto r = random_array(n, type);
+  std::vector<std::vector<double>> c(dim, std::vector<double>(n / dim));
+  for (unsigned i = 0; i < n / dim; ++i)
+    for (unsigned k = 0; k < dim; ++k) c[k][i] = r[dim * i + k];
+  return c;
+}
+
+template <typename Tag, typename Storage>
+double compare_1d_n(unsigned n, int distrib) {
+  auto c = random_columns(n, 1, distrib);
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 20; ++k) {
+    auto h = make_s(Tag(), Storage(), axis::regular<>(100, 0, 1));
+    auto t = clock();
+    h.fill(c[0]);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
+// like hs_ss_fill, but with floats and option_type::reciprocal
+template <typename Storage>
+double compare_1d_n_float(unsigned n, int distrib) {
+  auto c = random_columns(n, 1, distrib);
+  const std::vector<float> x(c[0].begin(), c[0].end());
+  using O = axis::option_type;
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 20; ++k) {
+    auto h = make_s(static_tag(), Storage(),
+                    axis::regular<axis::transform::identity<float>>(
+                        100, 0, 1, "", O::underflow_and_overflow | O::reciprocal));
+    auto t = clock();
+    h.fill(x);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
+template <typename Tag, typename Storage>
+double compare_2d_n(unsigned n, int distrib) {
+  auto c = random_columns(n, 2, distrib);
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 20; ++k) {
+    auto h =
+        make_s(Tag(), Storage(), axis::regular<>(100, 0, 1), axis::regular<>(100, 0, 1));
+    auto t = clock();
+    h.fill(c[0], c[1]);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
+template <typename Tag, typename Storage>
+double compare_3d_n(unsigned n, int distrib) {
+  auto c = random_columns(n, 3, distrib);
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 20; ++k) {
+    auto h = make_s(Tag(), Storage(), axis::regular<>(100, 0, 1),
+                    axis::regular<>(100, 0, 1), axis::regular<>(100, 0, 1));
+    auto t = clock();
+    h.fill(c[0], c[1], c[2]);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
+template <typename Tag, typename Storage>
+double compare_6d_n(unsigned n, int distrib) {
+  auto c = random_columns(n, 6, distrib);
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 20; ++k) {
+    auto h =
+        make_s(Tag(), Storage(), axis::regular<>(10, 0, 1), axis::regular<>(10, 0, 1),
+               axis::regular<>(10, 0, 1), axis::regular<>(10, 0, 1),
+               axis::regular<>(10, 0, 1), axis::regular<>(10, 0, 1));
+
+    auto t = clock();
+    h.fill(c[0], c[1], c[2], c[3], c[4], c[5]);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
 int main() {
   const unsigned nfill = 6000000;
 
@@ -133,9 +270,20 @@ int main() {
     else
       printf("normal distribution\n");
     printf("hs_ss %.3f\n", compare_1d<static_tag, std::vector<int>>(nfill, itype));
+    printf("hs_ss_static %.3f\n", compare_1d_static<std::vector<int>>(nfill, itype));
     printf("hs_sd %.3f\n", compare_1d<static_tag, adaptive_storage<>>(nfill, itype));
     printf("hd_ss %.3f\n", compare_1d<dynamic_tag, std::vector<int>>(nfill, itype));
     printf("hd_sd %.3f\n", compare_1d<dynamic_tag, adaptive_storage<>>(nfill, itype));
+    printf("hs_ss_fill %.3f\n",
+           compare_1d_n<static_tag, std::vector<int>>(nfill, itype));
+    printf("hs_ss_fill_float %.3f\n",
+           compare_1d_n_float<std::vector<int>>(nfill, itype));
+    printf("hs_sd_fill %.3f\n",
+           compare_1d_n<static_tag, adaptive_storage<>>(nfill, itype));
+    printf("hd_ss_fill %.3f\n",
+           compare_1d_n<dynamic_tag, std::vector<int>>(nfill, itype));
+    printf("hd_sd_fill %.3f\n",
+           compare_1d_n<dynamic_tag, adaptive_storage<>>(nfill, itype));
   }
 
   printf("2D\n");
@@ -145,9 +293,18 @@ int main() {
     else
       printf("normal distribution\n");
     printf("hs_ss %.3f\n", compare_2d<static_tag, std::vector<int>>(nfill, itype));
+    printf("hs_ss_static %.3f\n", compare_2d_static<std::vector<int>>(nfill, itype));
     printf("hs_sd %.3f\n", compare_2d<static_tag, adaptive_storage<>>(nfill, itype));
     printf("hd_ss %.3f\n", compare_2d<dynamic_tag, std::vector<int>>(nfill, itype));
     printf("hd_sd %.3f\n", compare_2d<dynamic_tag, adaptive_storage<>>(nfill, itype));
+    printf("hs_ss_fill %.3f\n",
+           compare_2d_n<static_tag, std::vector<int>>(nfill, itype));
+    printf("hs_sd_fill %.3f\n",
+           compare_2d_n<static_tag, adaptive_storage<>>(nfill, itype));
+    printf("hd_ss_fill %.3f\n",
+           compare_2d_n<dynamic_tag, std::vector<int>>(nfill, itype));
+    printf("hd_sd_fill %.3f\n",
+           compare_2d_n<dynamic_tag, adaptive_storage<>>(nfill, itype));
   }
 
   printf("3D\n");
@@ -160,6 +317,14 @@ int main() {
     printf("hs_sd %.3f\n", compare_3d<static_tag, adaptive_storage<>>(nfill, itype));
     printf("hd_ss %.3f\n", compare_3d<dynamic_tag, std::vector<int>>(nfill, itype));
     printf("hd_sd %.3f\n", compare_3d<dynamic_tag, adaptive_storage<>>(nfill, itype));
+    printf("hs_ss_fill %.3f\n",
+           compare_3d_n<static_tag, std::vector<int>>(nfill, itype));
+    printf("hs_sd_fill %.3f\n",
+           compare_3d_n<static_tag, adaptive_storage<>>(nfill, itype));
+    printf("hd_ss_fill %.3f\n",
+           compare_3d_n<dynamic_tag, std::vector<int>>(nfill, itype));
+    printf("hd_sd_fill %.3f\n",
+           compare_3d_n<dynamic_tag, adaptive_storage<>>(nfill, itype));
   }
 
   printf("6D\n");
@@ -172,5 +337,13 @@ int main() {
     printf("hs_sd %.3f\n", compare_6d<static_tag, adaptive_storage<>>(nfill, itype));
     printf("hd_ss %.3f\n", compare_6d<dynamic_tag, std::vector<int>>(nfill, itype));
     printf("hd_sd %.3f\n", compare_6d<dynamic_tag, adaptive_storage<>>(nfill, itype));
+    printf("hs_ss_fill %.3f\n",
+           compare_6d_n<static_tag, std::vector<int>>(nfill, itype));
+    printf("hs_sd_fill %.3f\n",
+           compare_6d_n<static_tag, adaptive_storage<>>(nfill, itype));
+    printf("hd_ss_fill %.3f\n",
+           compare_6d_n<dynamic_tag, std::vector<int>>(nfill, itype));
+    printf("hd_sd_fill %.3f\n",
+           compare_6d_n<dynamic_tag, adaptive_storage<>>(nfill, itype));
   }
 }
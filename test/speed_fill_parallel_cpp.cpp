@@ -0,0 +1,109 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <atomic>
+#include <boost/histogram.hpp>
+#include <boost/histogram/algorithm/fill_parallel.hpp>
+#include <boost/histogram/sharded_storage.hpp>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace boost::histogram;
+
+// same work-around as in examples/guide_parallel_filling.cpp
+template <typename T>
+class copyable_atomic : public std::atomic<T> {
+public:
+  using std::atomic<T>::atomic;
+  copyable_atomic() noexcept : std::atomic<T>(T()) {}
+  copyable_atomic(const copyable_atomic& rhs) : std::atomic<T>() { this->operator=(rhs); }
+  copyable_atomic& operator=(const copyable_atomic& rhs) {
+    if (this != &rhs) { std::atomic<T>::store(rhs.load()); }
+    return *this;
+  }
+};
+
+using atomic_storage = std::vector<copyable_atomic<std::size_t>>;
+
+// view of a part of an array, to pass sub-ranges to histogram::fill
+struct span {
+  const double* ptr;
+  std::size_t n;
+  const double* data() const { return ptr; }
+  const double* begin() const { return ptr; }
+  const double* end() const { return ptr + n; }
+};
+
+// type 0: uniform over all bins, type 1: about 90 % of the values in one bin
+std::vector<double> random_vector(std::size_t n, int type) {
+  std::vector<double> r(n);
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> d(0.0, 1.0);
+  for (auto&& ri : r) {
+    ri = d(gen);
+    if (type && ri < 0.9) ri = 0.505;
+  }
+  return r;
+}
+
+// best wall-clock time out of several repetitions
+template <typename F>
+double measure(F f) {
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 5; ++k) {
+    const auto t = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t;
+    best = std::min(best, dt.count());
+  }
+  return best;
+}
+
+// all threads fill the same histogram
+template <typename Storage>
+double compare_shared(const std::vector<double>& x, unsigned nthreads) {
+  return measure([&] {
+    auto h = make_histogram_with(Storage(), axis::regular<>(100, 0, 1));
+    std::vector<std::thread> threads;
+    for (unsigned k = 0; k < nthreads; ++k) {
+      const auto begin = x.size() * k / nthreads;
+      const auto end = x.size() * (k + 1) / nthreads;
+      const span s{&x[begin], end - begin};
+      threads.emplace_back([&h, s] { h.fill(s); });
+    }
+    for (auto&& t : threads) t.join();
+  });
+}
+
+template <typename Storage>
+double compare_fill_parallel(const std::vector<double>& x, unsigned nthreads) {
+  return measure([&] {
+    auto h = make_histogram_with(Storage(), axis::regular<>(100, 0, 1));
+    algorithm::fill_parallel(h, nthreads, x);
+  });
+}
+
+int main() {
+  const std::size_t nfill = 1 << 24;
+
+  printf("hardware threads %u\n", std::thread::hardware_concurrency());
+  for (int type : {0, 1}) {
+    printf(type ? "one hot bin\n" : "uniform distribution\n");
+    const auto x = random_vector(nfill, type);
+    for (unsigned nthreads : {1, 2, 4, 8, 16, 32, 64}) {
+      printf("threads %2u atomic %.3f sharded %.3f parallel_sd %.3f parallel_ss %.3f\n",
+             nthreads, compare_shared<atomic_storage>(x, nthreads),
+             compare_shared<sharded_storage<>>(x, nthreads),
+             compare_fill_parallel<adaptive_storage<>>(x, nthreads),
+             compare_fill_parallel<std::vector<std::size_t>>(x, nthreads));
+    }
+  }
+}
@@ -0,0 +1,62 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <boost/histogram.hpp>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace boost::histogram;
+
+// best wall-clock time out of several repetitions
+template <typename F>
+double measure(F f) {
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 5; ++k) {
+    const auto t = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t;
+    best = std::min(best, dt.count());
+  }
+  return best;
+}
+
+// histogram::fill uses the two-phase fill above the threshold, the direct path
+// computes all indices with index_n and then increments the storage in sample order
+template <typename Storage>
+void compare(unsigned bins, const std::vector<std::vector<double>>& x) {
+  auto h = make_histogram_with(Storage(), axis::regular<>(bins, 0, 1),
+                               axis::regular<>(bins, 0, 1), axis::regular<>(bins, 0, 1),
+                               axis::regular<>(bins, 0, 1));
+  const double t_fill = measure([&] { h.fill(x[0], x[1], x[2], x[3]); });
+  std::vector<std::size_t> idx(x[0].size());
+  const double t_direct = measure([&] {
+    h.index_n(idx.data(), x[0], x[1], x[2], x[3]);
+    h.fill_by_linear_index(idx);
+  });
+  printf("bins %10zu %s fill %.3f direct %.3f\n", h.size(),
+         h.size() >= detail::fill_n_sort_threshold ? "sorted" : "      ", t_fill,
+         t_direct);
+}
+
+int main() {
+  const std::size_t nfill = 1 << 22;
+
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> d(0.0, 1.0);
+  std::vector<std::vector<double>> x(4, std::vector<double>(nfill));
+  for (auto&& xi : x)
+    for (auto&& xij : xi) xij = d(gen);
+
+  printf("std::vector<double>\n");
+  for (unsigned bins : {8, 16, 32, 64, 96, 128})
+    compare<std::vector<double>>(bins, x);
+  printf("adaptive_storage\n");
+  for (unsigned bins : {8, 16, 32, 64, 96, 128}) compare<adaptive_storage<>>(bins, x);
+}
@@ -0,0 +1,88 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <boost/histogram.hpp>
+#include <boost/histogram/histogram_group.hpp>
+#include <cstdio>
+#include <ctime>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace boost::histogram;
+
+using axis_type = axis::variant<axis::regular<>, axis::variable<>>;
+using histogram_type = decltype(make_histogram(std::vector<axis_type>()));
+
+// best time out of several repetitions
+template <typename F>
+double measure(F f) {
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 5; ++k) {
+    const auto t = clock();
+    f();
+    best = std::min(best, double(clock() - t) / CLOCKS_PER_SEC);
+  }
+  return best;
+}
+
+int main() {
+  const std::size_t nfill = 1 << 20;
+  const unsigned nvalues = 4;
+
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> d(0.0, 1.0);
+  std::vector<std::vector<double>> v(nvalues, std::vector<double>(nfill));
+  for (auto&& vi : v)
+    for (auto&& x : vi) x = d(gen);
+
+  // one 1D histogram per value and one 2D histogram per pair of values, each value
+  // always uses the same axis
+  std::vector<axis_type> axes = {axis::regular<>(100, 0, 1),
+                                 axis::variable<>({0.0, 0.1, 0.2, 0.5, 0.7, 1.0}),
+                                 axis::regular<>(50, 0, 1), axis::regular<>(20, 0, 1)};
+  std::vector<histogram_type> hists;
+  std::vector<std::vector<unsigned>> columns;
+  for (unsigned i = 0; i < nvalues; ++i) {
+    hists.push_back(make_histogram(std::vector<axis_type>{axes[i]}));
+    columns.push_back({i});
+    for (unsigned j = i + 1; j < nvalues; ++j) {
+      hists.push_back(make_histogram(std::vector<axis_type>{axes[i], axes[j]}));
+      columns.push_back({i, j});
+    }
+  }
+
+  histogram_group<histogram_type> g;
+  for (std::size_t k = 0; k < hists.size(); ++k) g.add(hists[k], columns[k]);
+
+  printf("histograms %zu unique axes %zu\n", g.size(), g.unique_axes());
+
+  printf("single  separate %.3f group %.3f\n", measure([&] {
+           for (std::size_t i = 0; i < nfill; ++i)
+             for (std::size_t k = 0; k < hists.size(); ++k) {
+               const auto& c = columns[k];
+               if (c.size() == 1)
+                 hists[k](v[c[0]][i]);
+               else
+                 hists[k](v[c[0]][i], v[c[1]][i]);
+             }
+         }),
+         measure([&] {
+           for (std::size_t i = 0; i < nfill; ++i) g(v[0][i], v[1][i], v[2][i], v[3][i]);
+         }));
+
+  printf("batch   separate %.3f group %.3f\n", measure([&] {
+           for (std::size_t k = 0; k < hists.size(); ++k) {
+             const auto& c = columns[k];
+             if (c.size() == 1)
+               hists[k].fill(v[c[0]]);
+             else
+               hists[k].fill(v[c[0]], v[c[1]]);
+           }
+         }),
+         measure([&] { g.fill(v[0], v[1], v[2], v[3]); }));
+}
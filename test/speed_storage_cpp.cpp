@@ -0,0 +1,113 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <boost/histogram/adaptive_storage.hpp>
+#include <boost/histogram/chunked_adaptive_storage.hpp>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace boost::histogram;
+
+// allocator which keeps track of the current and peak number of allocated bytes
+struct memory_db {
+  static std::size_t current, peak;
+};
+std::size_t memory_db::current = 0;
+std::size_t memory_db::peak = 0;
+
+template <class T>
+struct counting_allocator {
+  using value_type = T;
+
+  counting_allocator() noexcept {}
+  template <class U>
+  counting_allocator(const counting_allocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    memory_db::current += n * sizeof(T);
+    memory_db::peak = std::max(memory_db::peak, memory_db::current);
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) {
+    memory_db::current -= n * sizeof(T);
+    ::operator delete((void*)p);
+  }
+};
+
+template <class T, class U>
+constexpr bool operator==(const counting_allocator<T>&,
+                          const counting_allocator<U>&) noexcept {
+  return true;
+}
+
+template <class T, class U>
+constexpr bool operator!=(const counting_allocator<T>&,
+                          const counting_allocator<U>&) noexcept {
+  return false;
+}
+
+// bin indices drawn from a Zipf distribution with exponent s; the rank of a bin is
+// shuffled, so that the hot bins are scattered over the whole storage
+std::vector<std::size_t> zipf_indices(std::size_t n, std::size_t nbins, double s) {
+  std::vector<double> cdf(nbins);
+  double sum = 0;
+  for (std::size_t k = 0; k < nbins; ++k) cdf[k] = (sum += std::pow(k + 1.0, -s));
+  for (auto&& c : cdf) c /= sum;
+  std::vector<std::size_t> bin(nbins);
+  std::iota(bin.begin(), bin.end(), 0);
+  std::default_random_engine gen(1);
+  std::shuffle(bin.begin(), bin.end(), gen);
+  std::uniform_real_distribution<> d;
+  std::vector<std::size_t> r(n);
+  for (auto&& ri : r) {
+    const auto k = std::lower_bound(cdf.begin(), cdf.end(), d(gen)) - cdf.begin();
+    ri = bin[std::min(static_cast<std::size_t>(k), nbins - 1)];
+  }
+  return r;
+}
+
+// best time out of several repetitions and peak memory of a fresh storage
+template <typename Storage>
+void measure(const char* name, std::size_t nbins, const std::vector<std::size_t>& x) {
+  auto best = std::numeric_limits<double>::max();
+  std::size_t peak = 0, final = 0;
+  for (unsigned k = 0; k < 5; ++k) {
+    memory_db::current = memory_db::peak = 0;
+    {
+      Storage s;
+      s.reset(nbins);
+      auto t = clock();
+      for (auto&& xi : x) s(xi);
+      t = clock() - t;
+      best = std::min(best, double(t) / CLOCKS_PER_SEC);
+      final = memory_db::current;
+    }
+    peak = memory_db::peak;
+  }
+  printf("%-8s %.3f s  final %6zu kB  peak %6zu kB\n", name, best, final / 1024,
+         peak / 1024);
+}
+
+int main() {
+  using A = counting_allocator<char>;
+  const std::size_t nbins = 1 << 20;
+  const std::size_t nfill = 1 << 24;
+
+  for (double s : {0.0, 1.0, 1.5}) {
+    printf("zipf s = %.1f\n", s);
+    const auto x = zipf_indices(nfill, nbins, s);
+    measure<adaptive_storage<A>>("plain", nbins, x);
+    measure<chunked_adaptive_storage<A, 1024>>("chunk1k", nbins, x);
+    measure<chunked_adaptive_storage<A, 4096>>("chunk4k", nbins, x);
+  }
+}
@@ -0,0 +1,113 @@
+// Copyright 2018 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/ostream_operators.hpp>
+#include <boost/histogram/accumulators/weighted_sum.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/summed_area_table.hpp>
+#include <stdexcept>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+
+// sum over box [b, e) computed from bin values
+template <typename T, typename H>
+T box_sum(const H& h, std::vector<int> b, std::vector<int> e) {
+  T s = T();
+  for (int i = b[0]; i < e[0]; ++i)
+    for (int j = b[1]; j < e[1]; ++j)
+      for (int k = b[2]; k < e[2]; ++k) s += h.at(i, j, k);
+  return s;
+}
+
+template <typename T, typename H>
+void test_boxes(const summed_area_table<T>& t, const H& h) {
+  const int lo[3] = {-1, 0, 0}, hi[3] = {6, 5, 4};
+  for (int b0 = lo[0]; b0 <= hi[0]; b0 += 2)
+    for (int e0 = b0; e0 <= hi[0]; e0 += 3)
+      for (int b1 = lo[1]; b1 <= hi[1]; ++b1)
+        for (int e1 = b1; e1 <= hi[1]; e1 += 2)
+          for (int b2 = lo[2]; b2 <= hi[2]; ++b2)
+            for (int e2 = b2; e2 <= hi[2]; ++e2)
+              BOOST_TEST_EQ(t.sum({b0, b1, b2}, {e0, e1, e2}),
+                            box_sum<T>(h, {b0, b1, b2}, {e0, e1, e2}));
+}
+
+template <typename Tag>
+void run_tests() {
+  // mixed flow bins, boxes including flow bins
+  {
+    auto h = make(Tag(), axis::integer<>(0, 5),
+                  axis::integer<>(0, 4, "", axis::option_type::overflow),
+                  axis::integer<>(0, 4, "", axis::option_type::none));
+    for (int i = 0; i < 500; ++i) h(i % 8 - 1, i % 6, i % 5);
+    summed_area_table<> t(h);
+    BOOST_TEST_EQ(t.rank(), 3);
+    test_boxes(t, h);
+
+    // incremental update, in a late slice of the last axis and in the first slice
+    h(2, 1, 3);
+    t.update(h);
+    test_boxes(t, h);
+    h(-1, 4, 0);
+    t.update(h);
+    test_boxes(t, h);
+    t.update(h);
+    test_boxes(t, h);
+
+    BOOST_TEST_THROWS(t.sum({0, 0}, {1, 1}), std::invalid_argument);
+    BOOST_TEST_THROWS(t.sum({-2, 0, 0}, {1, 1, 1}), std::out_of_range);
+    BOOST_TEST_THROWS(t.sum({0, 0, 0}, {1, 6, 1}), std::out_of_range);
+    BOOST_TEST_THROWS(t.sum({0, 2, 0}, {1, 1, 1}), std::out_of_range);
+  }
+
+  // weighted sums
+  {
+    auto h = make_s(Tag(), weight_storage(), axis::integer<>(0, 5), axis::integer<>(0, 4),
+                    axis::integer<>(0, 3));
+    for (int i = 0; i < 500; ++i) h(weight(0.5 * (i % 3)), i % 8 - 1, i % 6 - 1, i % 5);
+    summed_area_table<accumulators::weighted_sum<>> t(h);
+    const auto s = t.sum({0, -1, 0}, {4, 3, 2});
+    const auto s2 = box_sum<accumulators::weighted_sum<>>(h, {0, -1, 0}, {4, 3, 2});
+    BOOST_TEST_EQ(s.value(), s2.value());
+    BOOST_TEST_EQ(s.variance(), s2.variance());
+  }
+
+  // axis grows, table is rebuilt
+  {
+    auto h = make(Tag(), axis::regular<>(2, 0, 2, "", axis::option_type::growth));
+    h(0.5);
+    summed_area_table<> t(h);
+    BOOST_TEST_EQ(t.sum({0}, {2}), 1);
+    h(3.5);
+    t.update(h);
+    BOOST_TEST_EQ(t.sum({0}, {static_cast<int>(h.axis().size())}), 2);
+  }
+
+  // large table in several threads
+  {
+    auto h = make(Tag(), axis::integer<>(0, 100), axis::integer<>(0, 60),
+                  axis::integer<>(0, 30));
+    for (int i = 0; i < 20000; ++i) h(i % 103 - 1, i % 61, i % 29 + i % 3);
+    summed_area_table<> t1(h), t2(h, 3);
+    BOOST_TEST_EQ(t2.sum({-1, -1, -1}, {101, 61, 31}), 20000);
+    BOOST_TEST_EQ(t2.sum({3, 5, 7}, {80, 50, 20}), t1.sum({3, 5, 7}, {80, 50, 20}));
+    h(5, 5, 25);
+    t2.update(h, 3);
+    BOOST_TEST_EQ(t2.sum({5, 5, 25}, {6, 6, 26}), h.at(5, 5, 25));
+    BOOST_TEST_EQ(t2.sum({-1, -1, -1}, {101, 61, 31}), 20001);
+  }
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  return boost::report_errors();
+}